@@ -0,0 +1,87 @@
+#pragma once
+#include <core/config.h>
+#include <core/span.h>
+#include <core/string.h>
+
+#include <istream>
+#include <memory>
+#include <vector>
+
+#include <cstddef>
+
+namespace core {
+
+// Input of `LineReader`: file descriptor, stream or memory
+class CORE_LIB_EXPORT ByteSource
+{
+public:
+	virtual ~ByteSource() = default;
+
+	// Returns count of bytes written to `dest`, 0 at the end of input
+	virtual std::size_t read(char* dest, std::size_t size) = 0;
+
+	static std::unique_ptr<ByteSource> FromStream(std::istream& in);
+	// `fd` is not closed
+	static std::unique_ptr<ByteSource> FromFileDescriptor(int fd);
+	// `data` should outlive the source
+	static std::unique_ptr<ByteSource> FromMemory(std::string_view data);
+};
+
+enum class LinesLifetime
+{
+	// Memory of the line is reused after next `LineReader::next_line()`
+	UntilNextLine,
+	// Lines stay valid while `LineReader` is alive (e.g., when parsed
+	// symbols refer to the line after it was translated)
+	WhileReaderIsAlive,
+};
+
+// Splits input to lines the same way as `std::getline()` does
+// ('\n' is removed, everything else is kept as is) without copying
+// every line: input is read with big chunks and lines are views into them.
+// Only a line that crosses the end of a chunk is moved to the next chunk
+class CORE_LIB_EXPORT LineReader
+{
+public:
+	static constexpr std::size_t k_default_chunk_size = 1024 * 1024;
+
+	explicit LineReader(std::unique_ptr<ByteSource> source,
+		LinesLifetime lifetime = LinesLifetime::UntilNextLine,
+		std::size_t chunk_size = k_default_chunk_size);
+
+	// Returns false at the end of input. Line is writable,
+	// so it can be changed in place (e.g., converted to upper case)
+	bool next_line(Span<char>& line);
+
+	std::size_t lines_count() const;
+	// False when next line has to be read from `ByteSource`
+	// (e.g., may wait for interactive input)
+	bool has_buffered_input() const;
+
+private:
+	struct Chunk
+	{
+		std::unique_ptr<char[]> data;
+		std::size_t size{0};
+	};
+
+	void read_more();
+	void make_space();
+
+private:
+	std::unique_ptr<ByteSource> source_;
+	LinesLifetime lifetime_;
+	std::size_t chunk_size_;
+	Chunk current_;
+	// Not consumed data of `current_` is [begin_, end_),
+	// there is no '\n' in [begin_, scanned_)
+	std::size_t begin_;
+	std::size_t scanned_;
+	std::size_t end_;
+	bool end_of_input_;
+	std::size_t lines_count_;
+	// Chunks with lines handed out before (`WhileReaderIsAlive` only)
+	std::vector<Chunk> retired_;
+};
+
+} // namespace core
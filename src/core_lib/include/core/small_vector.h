@@ -0,0 +1,284 @@
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+#include <cassert>
+
+namespace core {
+
+// Vector that keeps up to `N` elements inside the object itself
+// and allocates only when more elements are added.
+// Subset of std::vector interface (no insert/erase in the middle)
+template<typename T, std::size_t N>
+class SmallVector
+{
+	static_assert(N > 0, "Use std::vector when no inline elements needed");
+
+public:
+	using value_type = T;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	SmallVector() noexcept = default;
+
+	SmallVector(const SmallVector& other)
+	{
+		reserve(other.size_);
+		std::uninitialized_copy(other.begin(), other.end(), data());
+		size_ = other.size_;
+	}
+
+	SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		take(std::move(other));
+	}
+
+	SmallVector& operator=(const SmallVector& other)
+	{
+		if (this != &other)
+		{
+			SmallVector copy{other};
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+	{
+		if (this != &other)
+		{
+			release();
+			take(std::move(other));
+		}
+		return *this;
+	}
+
+	~SmallVector()
+	{
+		release();
+	}
+
+	T* data() noexcept { return heap_ ? heap_ : inline_data(); }
+	const T* data() const noexcept { return heap_ ? heap_ : inline_data(); }
+	std::size_t size() const noexcept { return size_; }
+	std::size_t capacity() const noexcept { return heap_ ? capacity_ : N; }
+	bool empty() const noexcept { return (size_ == 0); }
+	// Elements are stored inside the object
+	bool is_inline() const noexcept { return !heap_; }
+
+	iterator begin() noexcept { return data(); }
+	iterator end() noexcept { return data() + size_; }
+	const_iterator begin() const noexcept { return data(); }
+	const_iterator end() const noexcept { return data() + size_; }
+	const_iterator cbegin() const noexcept { return begin(); }
+	const_iterator cend() const noexcept { return end(); }
+
+	T& operator[](std::size_t index)
+	{
+		assert(index < size_);
+		return data()[index];
+	}
+
+	const T& operator[](std::size_t index) const
+	{
+		assert(index < size_);
+		return data()[index];
+	}
+
+	T& front() { return (*this)[0]; }
+	const T& front() const { return (*this)[0]; }
+	T& back() { return (*this)[size_ - 1]; }
+	const T& back() const { return (*this)[size_ - 1]; }
+
+	// Nothing is changed if moving (or copying) of elements throws
+	void reserve(std::size_t capacity)
+	{
+		if (capacity <= this->capacity())
+		{
+			return;
+		}
+
+		T* heap = Allocate(capacity);
+		try
+		{
+			move_elements_to(heap);
+		}
+		catch (...)
+		{
+			Deallocate(heap);
+			throw;
+		}
+		replace_storage(heap, capacity);
+	}
+
+	template<typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (size_ < capacity())
+		{
+			T* element = ::new (static_cast<void*>(data() + size_)) T(std::forward<Args>(args)...);
+			++size_;
+			return *element;
+		}
+
+		// New element is constructed before old ones are moved,
+		// since `args` may refer to them (e.g., `push_back(v[0])`)
+		const std::size_t capacity = std::max<std::size_t>(2 * this->capacity(), N + 1);
+		T* heap = Allocate(capacity);
+		T* element = nullptr;
+		try
+		{
+			element = ::new (static_cast<void*>(heap + size_)) T(std::forward<Args>(args)...);
+			move_elements_to(heap);
+		}
+		catch (...)
+		{
+			if (element)
+			{
+				std::destroy_at(element);
+			}
+			Deallocate(heap);
+			throw;
+		}
+		replace_storage(heap, capacity);
+		++size_;
+		return *element;
+	}
+
+	void push_back(const T& value)
+	{
+		emplace_back(value);
+	}
+
+	void push_back(T&& value)
+	{
+		emplace_back(std::move(value));
+	}
+
+	void pop_back()
+	{
+		assert(size_ > 0);
+		--size_;
+		std::destroy_at(data() + size_);
+	}
+
+	// Keeps allocated capacity
+	void clear() noexcept
+	{
+		std::destroy(begin(), end());
+		size_ = 0;
+	}
+
+	friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+	{
+		return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+	friend bool operator!=(const SmallVector& lhs, const SmallVector& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+private:
+	T* inline_data() noexcept
+	{
+		return std::launder(reinterpret_cast<T*>(&inline_));
+	}
+
+	const T* inline_data() const noexcept
+	{
+		return std::launder(reinterpret_cast<const T*>(&inline_));
+	}
+
+	// Expects `this` to be empty
+	void take(SmallVector&& other)
+	{
+		if (other.heap_)
+		{
+			heap_ = std::exchange(other.heap_, nullptr);
+			capacity_ = std::exchange(other.capacity_, 0);
+			size_ = std::exchange(other.size_, 0);
+			return;
+		}
+
+		std::uninitialized_move(other.begin(), other.end(), inline_data());
+		size_ = other.size_;
+		other.clear();
+	}
+
+	void release() noexcept
+	{
+		clear();
+		deallocate_heap();
+	}
+
+	void deallocate_heap() noexcept
+	{
+		Deallocate(heap_);
+		heap_ = nullptr;
+		capacity_ = 0;
+	}
+
+	// Elements are copied when move may throw (same as std::vector does),
+	// so on exception old elements are left untouched
+	void move_elements_to(T* heap)
+	{
+		T* old = data();
+		if constexpr (std::is_nothrow_move_constructible<T>::value
+			|| !std::is_copy_constructible<T>::value)
+		{
+			std::uninitialized_move(old, old + size_, heap);
+		}
+		else
+		{
+			std::uninitialized_copy(old, old + size_, heap);
+		}
+	}
+
+	void replace_storage(T* heap, std::size_t capacity) noexcept
+	{
+		T* old = data();
+		std::destroy(old, old + size_);
+		deallocate_heap();
+		heap_ = heap;
+		capacity_ = capacity;
+	}
+
+	static constexpr bool k_over_aligned = (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+	static T* Allocate(std::size_t capacity)
+	{
+		if constexpr (k_over_aligned)
+		{
+			return static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{alignof(T)}));
+		}
+		else
+		{
+			return static_cast<T*>(::operator new(capacity * sizeof(T)));
+		}
+	}
+
+	static void Deallocate(T* heap) noexcept
+	{
+		if constexpr (k_over_aligned)
+		{
+			::operator delete(heap, std::align_val_t{alignof(T)});
+		}
+		else
+		{
+			::operator delete(heap);
+		}
+	}
+
+private:
+	T* heap_ = nullptr;
+	std::size_t size_ = 0;
+	std::size_t capacity_ = 0;
+	std::aligned_storage_t<sizeof(T) * N, alignof(T)> inline_;
+};
+
+} // namespace core
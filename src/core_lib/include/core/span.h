@@ -0,0 +1,88 @@
+#pragma once
+#include <type_traits>
+#include <utility>
+
+#include <cstddef>
+#include <cassert>
+
+namespace core {
+
+// Non-owning view of contiguous sequence of `T`.
+// Subset of C++20 std::span (dynamic extent only)
+template<typename T>
+class Span
+{
+public:
+	using element_type = T;
+	using value_type = std::remove_cv_t<T>;
+	using iterator = T*;
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	constexpr Span() noexcept = default;
+
+	constexpr Span(T* data, std::size_t size) noexcept
+		: data_{data}
+		, size_{size}
+	{
+	}
+
+	template<std::size_t N>
+	constexpr Span(T (&array)[N]) noexcept
+		: data_{array}
+		, size_{N}
+	{
+	}
+
+	// Any container with contiguous storage (std::vector, std::array, ...)
+	template<typename Container
+		, typename = std::enable_if_t<std::is_convertible<
+			decltype(std::declval<Container&>().data()), T*>::value>>
+	constexpr Span(Container& container) noexcept
+		: data_{container.data()}
+		, size_{container.size()}
+	{
+	}
+
+	// Span<T> -> Span<const T>
+	template<typename U
+		, typename = std::enable_if_t<std::is_convertible<U(*)[], T(*)[]>::value>>
+	constexpr Span(const Span<U>& other) noexcept
+		: data_{other.data()}
+		, size_{other.size()}
+	{
+	}
+
+	constexpr T* data() const noexcept { return data_; }
+	constexpr std::size_t size() const noexcept { return size_; }
+	constexpr bool empty() const noexcept { return (size_ == 0); }
+
+	constexpr iterator begin() const noexcept { return data_; }
+	constexpr iterator end() const noexcept { return data_ + size_; }
+
+	constexpr T& operator[](std::size_t index) const
+	{
+		assert(index < size_);
+		return data_[index];
+	}
+
+	constexpr Span first(std::size_t count) const
+	{
+		assert(count <= size_);
+		return Span{data_, count};
+	}
+
+	// Clamps to the end of span
+	constexpr Span subspan(std::size_t offset, std::size_t count = npos) const
+	{
+		assert(offset <= size_);
+		const std::size_t available = (size_ - offset);
+		return Span{data_ + offset, (count < available) ? count : available};
+	}
+
+private:
+	T* data_ = nullptr;
+	std::size_t size_ = 0;
+};
+
+} // namespace core
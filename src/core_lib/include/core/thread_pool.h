@@ -0,0 +1,67 @@
+#pragma once
+#include <core/config.h>
+
+#include <functional>
+#include <exception>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <deque>
+
+#include <cstddef>
+
+namespace core {
+
+// Fixed-size pool of threads with per-thread task queues.
+// Worker takes tasks from the back of own queue (LIFO) and,
+// when it's empty, steals from the front of other queues.
+// Tasks submitted from worker thread go to worker's own queue
+class CORE_LIB_EXPORT ThreadPool
+{
+public:
+	using Task = std::function<void ()>;
+
+	// 0 means std::thread::hardware_concurrency()
+	explicit ThreadPool(std::size_t threads_count = 0);
+	// Finishes all submitted tasks
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	std::size_t threads_count() const;
+
+	void submit(Task task);
+	// Blocks until all submitted tasks are finished.
+	// Re-throws first exception thrown by any task (if any)
+	void wait();
+
+private:
+	struct TasksQueue
+	{
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	void worker_loop(std::size_t index);
+	bool pop_task(std::size_t index, Task& task);
+	void on_task_done(std::exception_ptr error);
+
+private:
+	std::vector<std::unique_ptr<TasksQueue>> queues_;
+	std::vector<std::thread> threads_;
+
+	std::mutex mutex_;
+	std::condition_variable has_tasks_;
+	std::condition_variable all_done_;
+	// Guarded by `mutex_`
+	std::size_t queued_tasks_;
+	std::size_t pending_tasks_;
+	std::size_t next_queue_;
+	std::exception_ptr first_error_;
+	bool stop_;
+};
+
+} // namespace core
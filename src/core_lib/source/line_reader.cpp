@@ -0,0 +1,240 @@
+#include <core/line_reader.h>
+
+#include <algorithm>
+#include <system_error>
+
+#include <cstring>
+#include <climits>
+#include <cerrno>
+#include <cassert>
+
+#if defined(_WIN32)
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace core {
+
+namespace {
+
+class StreamSource final :
+	public ByteSource
+{
+public:
+	explicit StreamSource(std::istream& in)
+		: in_{in}
+	{
+	}
+
+	virtual std::size_t read(char* dest, std::size_t size) override
+	{
+		using Traits = std::istream::traits_type;
+
+		auto* buffer = in_.rdbuf();
+		if (!buffer || (size == 0))
+		{
+			return 0;
+		}
+
+		// Takes only what is available without blocking (at least one char),
+		// so interactive input is handled line by line, as with `std::getline()`
+		if ((buffer->in_avail() <= 0) &&
+			Traits::eq_int_type(buffer->sgetc(), Traits::eof()))
+		{
+			in_.setstate(std::ios_base::eofbit);
+			return 0;
+		}
+		const auto available = std::max<std::streamsize>(buffer->in_avail(), 1);
+		const auto count = buffer->sgetn(dest,
+			std::min(available, static_cast<std::streamsize>(size)));
+		return static_cast<std::size_t>(count);
+	}
+
+private:
+	std::istream& in_;
+};
+
+class FileDescriptorSource final :
+	public ByteSource
+{
+public:
+	explicit FileDescriptorSource(int fd)
+		: fd_{fd}
+	{
+	}
+
+	virtual std::size_t read(char* dest, std::size_t size) override
+	{
+		for (;;)
+		{
+#if defined(_WIN32)
+			const auto count = ::_read(fd_, dest,
+				static_cast<unsigned>(std::min<std::size_t>(size, INT_MAX)));
+#else
+			const auto count = ::read(fd_, dest, size);
+#endif
+			if (count >= 0)
+			{
+				return static_cast<std::size_t>(count);
+			}
+			if (errno != EINTR)
+			{
+				throw std::system_error{errno, std::generic_category(), "read"};
+			}
+		}
+	}
+
+private:
+	int fd_;
+};
+
+class MemorySource final :
+	public ByteSource
+{
+public:
+	explicit MemorySource(std::string_view data)
+		: data_{data}
+	{
+	}
+
+	virtual std::size_t read(char* dest, std::size_t size) override
+	{
+		const auto count = std::min(size, data_.size());
+		std::memcpy(dest, data_.data(), count);
+		data_.remove_prefix(count);
+		return count;
+	}
+
+private:
+	std::string_view data_;
+};
+
+} // namespace
+
+/*static*/ std::unique_ptr<ByteSource> ByteSource::FromStream(std::istream& in)
+{
+	return std::make_unique<StreamSource>(in);
+}
+
+/*static*/ std::unique_ptr<ByteSource> ByteSource::FromFileDescriptor(int fd)
+{
+	return std::make_unique<FileDescriptorSource>(fd);
+}
+
+/*static*/ std::unique_ptr<ByteSource> ByteSource::FromMemory(std::string_view data)
+{
+	return std::make_unique<MemorySource>(data);
+}
+
+/*explicit*/ LineReader::LineReader(std::unique_ptr<ByteSource> source,
+	LinesLifetime lifetime /*= LinesLifetime::UntilNextLine*/,
+	std::size_t chunk_size /*= k_default_chunk_size*/)
+		: source_{std::move(source)}
+		, lifetime_{lifetime}
+		, chunk_size_{std::max<std::size_t>(chunk_size, 1)}
+		, current_()
+		, begin_{0}
+		, scanned_{0}
+		, end_{0}
+		, end_of_input_{false}
+		, lines_count_{0}
+		, retired_()
+{
+	assert(source_);
+}
+
+bool LineReader::next_line(Span<char>& line)
+{
+	for (;;)
+	{
+		char* data = current_.data.get();
+		if (scanned_ < end_)
+		{
+			const void* new_line = std::memchr(data + scanned_, '\n', end_ - scanned_);
+			if (new_line)
+			{
+				const auto line_end = static_cast<std::size_t>(
+					static_cast<const char*>(new_line) - data);
+				line = Span<char>{data + begin_, line_end - begin_};
+				begin_ = line_end + 1;
+				scanned_ = begin_;
+				++lines_count_;
+				return true;
+			}
+			scanned_ = end_;
+		}
+
+		if (end_of_input_)
+		{
+			if (begin_ == end_)
+			{
+				return false;
+			}
+			// Last line without '\n'
+			line = Span<char>{data + begin_, end_ - begin_};
+			begin_ = end_;
+			scanned_ = end_;
+			++lines_count_;
+			return true;
+		}
+
+		read_more();
+	}
+}
+
+std::size_t LineReader::lines_count() const
+{
+	return lines_count_;
+}
+
+bool LineReader::has_buffered_input() const
+{
+	return (begin_ < end_);
+}
+
+void LineReader::read_more()
+{
+	if (end_ == current_.size)
+	{
+		make_space();
+	}
+
+	const auto count = source_->read(current_.data.get() + end_, current_.size - end_);
+	end_ += count;
+	end_of_input_ = (count == 0);
+}
+
+void LineReader::make_space()
+{
+	const std::size_t tail = end_ - begin_;
+	if (current_.data && (lifetime_ == LinesLifetime::UntilNextLine)
+		&& ((tail * 2) <= current_.size))
+	{
+		// Lines before `begin_` are not used anymore
+		std::memmove(current_.data.get(), current_.data.get() + begin_, tail);
+	}
+	else
+	{
+		// Not finished line is moved to the new chunk, that is bigger
+		// when the line does not fit into half of the chunk
+		Chunk chunk;
+		chunk.size = std::max(chunk_size_, tail * 2);
+		chunk.data.reset(new char[chunk.size]);
+		if (tail > 0)
+		{
+			std::memcpy(chunk.data.get(), current_.data.get() + begin_, tail);
+		}
+		if (current_.data && (lifetime_ == LinesLifetime::WhileReaderIsAlive))
+		{
+			retired_.push_back(std::move(current_));
+		}
+		current_ = std::move(chunk);
+	}
+
+	scanned_ -= begin_;
+	begin_ = 0;
+	end_ = tail;
+}
+
+} // namespace core
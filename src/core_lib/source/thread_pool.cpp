@@ -0,0 +1,196 @@
+#include <core/thread_pool.h>
+
+#include <algorithm>
+
+#include <cassert>
+
+namespace core {
+
+namespace {
+
+// Set for worker threads only, so `submit()` from inside
+// of a task can push to the worker's own queue
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local std::size_t tls_worker_index = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads_count /*= 0*/)
+	: queues_()
+	, threads_()
+	, mutex_()
+	, has_tasks_()
+	, all_done_()
+	, queued_tasks_{0}
+	, pending_tasks_{0}
+	, next_queue_{0}
+	, first_error_()
+	, stop_{false}
+{
+	if (threads_count == 0)
+	{
+		threads_count = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	queues_.reserve(threads_count);
+	for (std::size_t i = 0; i < threads_count; ++i)
+	{
+		queues_.push_back(std::make_unique<TasksQueue>());
+	}
+
+	threads_.reserve(threads_count);
+	for (std::size_t i = 0; i < threads_count; ++i)
+	{
+		threads_.emplace_back(&ThreadPool::worker_loop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::unique_lock<std::mutex> lock{mutex_};
+		all_done_.wait(lock, [this] { return (pending_tasks_ == 0); });
+		stop_ = true;
+	}
+	has_tasks_.notify_all();
+
+	for (auto& thread : threads_)
+	{
+		thread.join();
+	}
+}
+
+std::size_t ThreadPool::threads_count() const
+{
+	return threads_.size();
+}
+
+void ThreadPool::submit(Task task)
+{
+	assert(task);
+
+	std::size_t index = 0;
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		++pending_tasks_;
+		++queued_tasks_;
+		if (tls_pool == this)
+		{
+			index = tls_worker_index;
+		}
+		else
+		{
+			index = next_queue_;
+			next_queue_ = (next_queue_ + 1) % queues_.size();
+		}
+	}
+
+	{
+		auto& queue = *queues_[index];
+		std::lock_guard<std::mutex> lock{queue.mutex};
+		queue.tasks.push_back(std::move(task));
+	}
+	has_tasks_.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	std::exception_ptr error;
+	{
+		std::unique_lock<std::mutex> lock{mutex_};
+		all_done_.wait(lock, [this] { return (pending_tasks_ == 0); });
+		std::swap(error, first_error_);
+	}
+
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+void ThreadPool::worker_loop(std::size_t index)
+{
+	tls_pool = this;
+	tls_worker_index = index;
+
+	for (;;)
+	{
+		Task task;
+		if (pop_task(index, task))
+		{
+			std::exception_ptr error;
+			try
+			{
+				task();
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+			on_task_done(std::move(error));
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock{mutex_};
+		has_tasks_.wait(lock, [this] { return stop_ || (queued_tasks_ > 0); });
+		if (stop_ && (queued_tasks_ == 0))
+		{
+			break;
+		}
+	}
+}
+
+bool ThreadPool::pop_task(std::size_t index, Task& task)
+{
+	bool found = false;
+	{
+		auto& own = *queues_[index];
+		std::lock_guard<std::mutex> lock{own.mutex};
+		if (!own.tasks.empty())
+		{
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			found = true;
+		}
+	}
+
+	for (std::size_t i = 1; !found && (i < queues_.size()); ++i)
+	{
+		auto& other = *queues_[(index + i) % queues_.size()];
+		std::lock_guard<std::mutex> lock{other.mutex};
+		if (!other.tasks.empty())
+		{
+			task = std::move(other.tasks.front());
+			other.tasks.pop_front();
+			found = true;
+		}
+	}
+
+	if (found)
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		--queued_tasks_;
+	}
+	return found;
+}
+
+void ThreadPool::on_task_done(std::exception_ptr error)
+{
+	bool all_done = false;
+	{
+		std::lock_guard<std::mutex> lock{mutex_};
+		if (error && !first_error_)
+		{
+			first_error_ = std::move(error);
+		}
+		--pending_tasks_;
+		all_done = (pending_tasks_ == 0);
+	}
+
+	if (all_done)
+	{
+		all_done_.notify_all();
+	}
+}
+
+} // namespace core
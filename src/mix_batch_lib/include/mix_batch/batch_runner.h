@@ -0,0 +1,78 @@
+#pragma once
+#include <mix_batch/config.h>
+
+#include <mixal/line_translator.h>
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+#include <cstddef>
+
+namespace mix_batch {
+
+struct BatchTask
+{
+	std::string name;
+	// Text that is read by all input devices of the task (one shared
+	// position, white space is skipped, as default devices do)
+	std::string input;
+	// Max commands count to execute (-1 means "until halt")
+	int commands_budget{-1};
+};
+
+enum class ExitReason
+{
+	Halted,
+	BudgetExhausted,
+	Error,
+};
+
+MIX_BATCH_LIB_EXPORT
+const char* ExitReasonToString(ExitReason reason);
+
+struct BatchResult
+{
+	std::string name;
+	ExitReason exit_reason{ExitReason::Error};
+	// There is no MIX timing model, so executed commands
+	// count is used as task's cycles count
+	int commands_count{0};
+	// Everything written by all output devices of the task
+	std::string output;
+	std::string error;
+};
+
+struct BatchReport
+{
+	// In the same order as tasks
+	std::vector<BatchResult> results;
+	std::size_t halted_count{0};
+	std::size_t budget_exhausted_count{0};
+	std::size_t errors_count{0};
+	long long total_commands_count{0};
+};
+
+struct BatchOptions
+{
+	// 0 means "use all hardware threads"
+	std::size_t threads_count{0};
+};
+
+// Runs `program` on fresh Computer with all default devices bound
+// to streams over `task.input` and output (as `ExecuteProgram()` does)
+MIX_BATCH_LIB_EXPORT
+BatchResult RunTask(const mixal::TranslatedProgram& program, const BatchTask& task);
+
+// Runs `program` for every task in parallel
+// (one Computer per thread, reset to loaded program before each task)
+MIX_BATCH_LIB_EXPORT
+BatchReport RunBatch(const mixal::TranslatedProgram& program,
+	const std::vector<BatchTask>& tasks,
+	const BatchOptions& options = {});
+
+MIX_BATCH_LIB_EXPORT
+void PrintReport(std::ostream& out, const BatchReport& report,
+	bool with_output = false);
+
+} // namespace mix_batch
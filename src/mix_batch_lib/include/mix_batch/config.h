@@ -0,0 +1,3 @@
+#pragma once
+#include <mix_batch_lib_export.h>
+
@@ -0,0 +1,118 @@
+#include <mix_batch/batch_runner.h>
+
+#include "internal/task_machine.h"
+
+#include <core/thread_pool.h>
+
+#include <ostream>
+#include <algorithm>
+#include <atomic>
+
+namespace mix_batch {
+
+namespace {
+
+void AddToReport(BatchReport& report, const BatchResult& result)
+{
+	switch (result.exit_reason)
+	{
+	case ExitReason::Halted:
+		++report.halted_count;
+		break;
+	case ExitReason::BudgetExhausted:
+		++report.budget_exhausted_count;
+		break;
+	case ExitReason::Error:
+		++report.errors_count;
+		break;
+	}
+	report.total_commands_count += result.commands_count;
+}
+
+} // namespace
+
+const char* ExitReasonToString(ExitReason reason)
+{
+	switch (reason)
+	{
+	case ExitReason::Halted:
+		return "halted";
+	case ExitReason::BudgetExhausted:
+		return "budget exhausted";
+	case ExitReason::Error:
+		return "error";
+	}
+	return "unknown";
+}
+
+BatchResult RunTask(const mixal::TranslatedProgram& program, const BatchTask& task)
+{
+	internal::TaskMachine machine{program};
+	return machine.run(task);
+}
+
+BatchReport RunBatch(const mixal::TranslatedProgram& program,
+	const std::vector<BatchTask>& tasks,
+	const BatchOptions& options /*= {}*/)
+{
+	BatchReport report;
+	report.results.resize(tasks.size());
+
+	{
+		// One machine per worker: program is loaded once and
+		// restored from snapshot between tasks
+		core::ThreadPool pool{options.threads_count};
+		std::atomic<std::size_t> next_task{0};
+		const std::size_t workers_count = std::min(pool.threads_count(), tasks.size());
+		for (std::size_t i = 0; i < workers_count; ++i)
+		{
+			pool.submit([&program, &tasks, &report, &next_task]()
+			{
+				internal::TaskMachine machine{program};
+				for (std::size_t index = next_task++; index < tasks.size(); index = next_task++)
+				{
+					report.results[index] = machine.run(tasks[index]);
+				}
+			});
+		}
+		pool.wait();
+	}
+
+	for (const auto& result : report.results)
+	{
+		AddToReport(report, result);
+	}
+	return report;
+}
+
+void PrintReport(std::ostream& out, const BatchReport& report,
+	bool with_output /*= false*/)
+{
+	for (const auto& result : report.results)
+	{
+		out << result.name << ": " << ExitReasonToString(result.exit_reason)
+			<< ", commands: " << result.commands_count;
+		if (!result.error.empty())
+		{
+			out << ", error: " << result.error;
+		}
+		out << '\n';
+
+		if (with_output && !result.output.empty())
+		{
+			out << result.output;
+			if (result.output.back() != '\n')
+			{
+				out << '\n';
+			}
+		}
+	}
+
+	out << "Tasks: " << report.results.size()
+		<< ", halted: " << report.halted_count
+		<< ", budget exhausted: " << report.budget_exhausted_count
+		<< ", errors: " << report.errors_count
+		<< ", commands: " << report.total_commands_count << '\n';
+}
+
+} // namespace mix_batch
@@ -0,0 +1,109 @@
+#include "task_machine.h"
+
+#include <mixal/program_loader.h>
+
+#include <stdexcept>
+
+namespace mix_batch {
+namespace internal {
+
+namespace {
+
+std::string ErrorMessage(const std::exception_ptr& error)
+{
+	try
+	{
+		std::rethrow_exception(error);
+	}
+	catch (const std::exception& e)
+	{
+		return e.what();
+	}
+	catch (...)
+	{
+		return "unknown error";
+	}
+}
+
+} // namespace
+
+TaskMachine::TaskMachine(const mixal::TranslatedProgram& program)
+	: load_error_()
+	, input_()
+	, output_()
+	, computer_()
+	, loaded_()
+{
+	computer_.bind_devices(output_, input_);
+
+	if (program.start_address < 0)
+	{
+		load_error_ = "program has no start address";
+		return;
+	}
+
+	try
+	{
+		mixal::LoadProgram(computer_, program);
+	}
+	catch (const std::exception& e)
+	{
+		load_error_ = e.what();
+		return;
+	}
+	loaded_ = computer_.snapshot();
+}
+
+BatchResult TaskMachine::run(const BatchTask& task)
+{
+	if (!load_error_.empty())
+	{
+		return make_result(task, 0);
+	}
+
+	// Only memory pages written by previous task are copied back
+	computer_.restore(loaded_);
+	input_.clear();
+	input_.str(task.input);
+	output_.clear();
+	output_.str(std::string{});
+
+	const int commands_count = computer_.run(task.commands_budget);
+	return make_result(task, commands_count);
+}
+
+BatchResult TaskMachine::make_result(const BatchTask& task, int commands_count) const
+{
+	BatchResult result;
+	result.name = task.name;
+	result.commands_count = commands_count;
+	result.error = load_error_;
+	if (!load_error_.empty())
+	{
+		result.exit_reason = ExitReason::Error;
+		return result;
+	}
+
+	result.output = output_.str();
+	if (computer_.error())
+	{
+		result.error = ErrorMessage(computer_.error());
+	}
+
+	if (!result.error.empty())
+	{
+		result.exit_reason = ExitReason::Error;
+	}
+	else if (computer_.is_halted())
+	{
+		result.exit_reason = ExitReason::Halted;
+	}
+	else
+	{
+		result.exit_reason = ExitReason::BudgetExhausted;
+	}
+	return result;
+}
+
+} // namespace internal
+} // namespace mix_batch
@@ -0,0 +1,41 @@
+#pragma once
+#include <mix_batch/batch_runner.h>
+
+#include <mix/computer.h>
+
+#include <sstream>
+#include <string>
+
+namespace mix_batch {
+namespace internal {
+
+// Computer with loaded program and default devices bound to
+// machine's input/output streams, so input is read the same way as by
+// `ExecuteProgram()` (`mixal -e`). Program is loaded once; every task
+// starts from snapshot taken right after the load, with streams reset
+// to task's input, so one machine can run many tasks
+class TaskMachine
+{
+public:
+	explicit TaskMachine(const mixal::TranslatedProgram& program);
+
+	TaskMachine(const TaskMachine&) = delete;
+	TaskMachine& operator=(const TaskMachine&) = delete;
+
+	// Runs until halt or until task's budget is exhausted
+	BatchResult run(const BatchTask& task);
+
+private:
+	BatchResult make_result(const BatchTask& task, int commands_count) const;
+
+private:
+	std::string load_error_;
+	// Streams should outlive Computer's devices
+	std::istringstream input_;
+	std::ostringstream output_;
+	mix::Computer computer_;
+	mix::ComputerSnapshot loaded_;
+};
+
+} // namespace internal
+} // namespace mix_batch
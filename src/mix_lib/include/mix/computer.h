@@ -3,6 +3,11 @@
 #include <mix/registers.h>
 #include <mix/general_types.h>
 #include <mix/device_controller.h>
+#include <mix/computer_snapshot.h>
+
+#include <bitset>
+#include <exception>
+#include <iosfwd>
 
 namespace mix {
 
@@ -14,6 +19,11 @@ class MIX_LIB_EXPORT Computer
 public:
 	static constexpr std::size_t k_index_registers_count = 6;
 	static constexpr std::size_t k_memory_words_count = 4000;
+	static constexpr std::size_t k_memory_pages_count =
+		(k_memory_words_count / ComputerSnapshot::k_page_words_count);
+
+	static_assert((k_memory_words_count % ComputerSnapshot::k_page_words_count) == 0,
+		"Memory should be split into pages of the same size");
 
 	explicit Computer(IComputerListener* listener = nullptr);
 
@@ -31,6 +41,9 @@ public:
 	// (Note: now there is now way to resume processing)
 	void halt();
     bool is_halted() const;
+	// Exception that stopped `run_one()` (if any).
+	// Empty when Computer was halted by HLT command
+	std::exception_ptr error() const;
 
 	int current_address() const;
 	int next_address() const;
@@ -60,9 +73,23 @@ public:
 	IIODevice& device(DeviceId id);
 	IIODevice& wait_device_ready(DeviceId id);
 	void replace_device(DeviceId id, std::unique_ptr<IIODevice> device);
+	// Replaces all devices with default ones that work
+	// with given streams instead of std::cout/std::cin
+	void bind_devices(std::ostream& out, std::istream& in);
+
+	// Captures registers, flags, memory and devices positions.
+	// Memory pages that were not modified since last `snapshot()`/`restore()`
+	// are shared with previous snapshot (without copying).
+	ComputerSnapshot snapshot();
+	// Brings Computer back to the `snapshot` state. When restoring
+	// the same snapshot that was taken (or restored) last time,
+	// only memory pages modified since then are copied.
+	// Note: listener is not notified about any change
+	void restore(const ComputerSnapshot& snapshot);
 
 private:
-	void setup_default_devices();
+	void setup_default_devices(std::ostream& out, std::istream& in);
+	void mark_memory_page_dirty(int address);
 
 private:
 	Register ra_;
@@ -75,12 +102,18 @@ private:
 	OverflowFlag overflow_flag_;
 
 	std::array<Word, k_memory_words_count> memory_;
+	// Pages of last snapshot that was taken or restored.
+	// Memory page is equal to the one from this array if it
+	// is not marked as dirty
+	std::array<ComputerSnapshot::MemoryPageRef, k_memory_pages_count> memory_base_;
+	std::bitset<k_memory_pages_count> dirty_pages_;
 
 	DeviceController devices_;
 
 	IComputerListener* listener_;
 	bool halted_;
 	bool had_jump_;
+	std::exception_ptr error_;
 };
 
 
@@ -0,0 +1,52 @@
+#pragma once
+#include <mix/config.h>
+#include <mix/registers.h>
+#include <mix/io_device.h>
+#include <mix/device_controller.h>
+
+#include <array>
+#include <vector>
+#include <memory>
+
+namespace mix {
+
+// Immutable copy of `Computer` state (registers, flags, memory and
+// devices positions). Memory is split into pages that are shared between
+// snapshots (and `Computer` itself) until they are modified, so taking and
+// restoring snapshot of mostly unchanged memory is cheap.
+// See `Computer::snapshot()` and `Computer::restore()`
+class MIX_LIB_EXPORT ComputerSnapshot
+{
+public:
+	static constexpr std::size_t k_page_words_count = 50;
+
+	using MemoryPage = std::array<Word, k_page_words_count>;
+	using MemoryPageRef = std::shared_ptr<const MemoryPage>;
+
+	bool empty() const;
+
+private:
+	friend class Computer;
+
+	Register ra_;
+	Register rx_;
+	std::array<IndexRegister, 6> rindexes_;
+	AddressRegister rj_;
+	AddressRegister rip_;
+
+	ComparisonIndicator comparison_state_{ComparisonIndicator::Less};
+	OverflowFlag overflow_flag_{OverflowFlag::NoOverflow};
+
+	bool halted_{false};
+	bool had_jump_{false};
+
+	std::vector<MemoryPageRef> pages_;
+	std::array<DevicePosition, DeviceController::k_max_devices_count> devices_;
+};
+
+inline bool ComputerSnapshot::empty() const
+{
+	return pages_.empty();
+}
+
+} // namespace mix
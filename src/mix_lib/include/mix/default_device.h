@@ -1,14 +1,23 @@
 #pragma once
 #include <mix/io_device.h>
 
+#include <istream>
+#include <ostream>
+#include <memory>
+
 namespace mix {
 
 class SymbolDevice final:
 	public IIODevice
 {
 public:
+	// Streams are not owned, position of them is not saved
+	// (it's unknown for snapshots)
 	SymbolDevice(int block_size, std::ostream& out, std::istream& in,
 		bool handle_new_line = false);
+	// Owned streams are rewound on snapshot restore
+	SymbolDevice(int block_size, std::unique_ptr<std::ostream> out,
+		std::unique_ptr<std::istream> in, bool handle_new_line = false);
 
 	virtual bool ready() const override;
 	virtual int block_size() const override;
@@ -17,6 +26,9 @@ public:
 	virtual Block read(DeviceBlockId block_id) override;
 	virtual void write(DeviceBlockId block_id, Block&&) override;
 
+	virtual DevicePosition position() const override;
+	virtual void set_position(const DevicePosition& position) override;
+
 private:
 	void write_word(const Word& word);
 	void write_byte(const Byte& byte);
@@ -31,6 +43,8 @@ private:
 private:
 	const int block_size_;
 	std::size_t current_column_;
+	std::unique_ptr<std::ostream> owned_out_;
+	std::unique_ptr<std::istream> owned_in_;
 	std::ostream& out_;
 	std::istream& in_;
 	bool handle_new_line_;
@@ -40,7 +54,10 @@ class BinaryDevice final :
 	public IIODevice
 {
 public:
+	// See `SymbolDevice` constructors
 	BinaryDevice(int block_size, std::ostream& out, std::istream& in);
+	BinaryDevice(int block_size, std::unique_ptr<std::ostream> out,
+		std::unique_ptr<std::istream> in);
 
 	virtual bool ready() const override;
 	virtual int block_size() const override;
@@ -49,12 +66,17 @@ public:
 	virtual Block read(DeviceBlockId block_id) override;
 	virtual void write(DeviceBlockId block_id, Block&&) override;
 
+	virtual DevicePosition position() const override;
+	virtual void set_position(const DevicePosition& position) override;
+
 private:
 	void write_word(const Word& word);
 	Word read_word();
 
 private:
 	const int block_size_;
+	std::unique_ptr<std::ostream> owned_out_;
+	std::unique_ptr<std::istream> owned_in_;
 	std::ostream& out_;
 	std::istream& in_;
 };
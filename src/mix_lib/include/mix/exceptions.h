@@ -1,5 +1,6 @@
 #pragma once
 #include <stdexcept>
+#include <string>
 
 namespace mix {
 
@@ -81,5 +82,25 @@ public:
 	}
 };
 
+class DeviceFileOpenError :
+	public MixException
+{
+public:
+	DeviceFileOpenError(const std::string& file_path)
+		: MixException{"can't open device file: " + file_path}
+	{
+	}
+};
+
+class DeviceFileReadError :
+	public MixException
+{
+public:
+	DeviceFileReadError(const std::string& file_path)
+		: MixException{"can't read device file: " + file_path}
+	{
+	}
+};
+
 } // namespace mix
 
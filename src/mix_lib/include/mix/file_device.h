@@ -0,0 +1,46 @@
+#pragma once
+#include <mix/io_device.h>
+
+#include <memory>
+#include <string>
+
+namespace mix {
+
+// Symbol input device that reads records of text file (one line per
+// record, longer line is split into few records) on background thread ahead of
+// `read()` calls. Decoded blocks are handed over through bounded queue,
+// so `read()` never waits for the disk. Device is not ready only when
+// next block is not decoded yet (`read()` blocks until it is).
+// Blocks past the end of file are all spaces; if reading failed,
+// `read()` throws the error instead. Writes are ignored
+class MIX_LIB_EXPORT FileReaderDevice final :
+	public IIODevice
+{
+public:
+	static constexpr std::size_t k_default_read_ahead_blocks = 256;
+
+	FileReaderDevice(int block_size, const std::string& file_path,
+		std::size_t read_ahead_blocks = k_default_read_ahead_blocks);
+	virtual ~FileReaderDevice() override;
+
+	virtual bool ready() const override;
+	virtual int block_size() const override;
+
+	virtual Block prepare_block() const override;
+	virtual Block read(DeviceBlockId block_id) override;
+	virtual void write(DeviceBlockId block_id, Block&&) override;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl_;
+};
+
+// Card reader (device 16): 80 columns (16 words) per card
+MIX_LIB_EXPORT
+std::unique_ptr<IIODevice> MakeCardReaderDevice(const std::string& file_path);
+
+// Paper tape reader (device 20): 70 characters (14 words) per block
+MIX_LIB_EXPORT
+std::unique_ptr<IIODevice> MakePaperTapeReaderDevice(const std::string& file_path);
+
+} // namespace mix
@@ -5,6 +5,8 @@
 
 #include <vector>
 
+#include <cstdint>
+
 namespace mix {
 
 class MIX_LIB_EXPORT IIODeviceListener
@@ -17,6 +19,15 @@ protected:
 	~IIODeviceListener() = default;
 };
 
+// Position of device's input and output streams.
+// Negative value means "unknown" (e.g., device can't be rewound)
+struct DevicePosition
+{
+	std::int64_t input = -1;
+	std::int64_t output = -1;
+	std::size_t column = 0;
+};
+
 class IIODevice
 {
 public:
@@ -30,6 +41,11 @@ public:
 	virtual Block prepare_block() const = 0;
 	virtual Block read(DeviceBlockId block_id) = 0;
 	virtual void write(DeviceBlockId block_id, Block&&) = 0;
+
+	// Used by `Computer::snapshot()`/`Computer::restore()`.
+	// By default, device does not support rewinding
+	virtual DevicePosition position() const { return {}; }
+	virtual void set_position(const DevicePosition& /*position*/) {}
 };
 
 } // namespace mix
@@ -23,6 +23,27 @@ const char k_chars_table[] =
 	//'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
 };
 
+// Reverse of `k_chars_table`: MIX byte for each `char` value, -1 if none
+struct CharsToBytesTable
+{
+	int bytes[256];
+
+	constexpr CharsToBytesTable()
+		: bytes{}
+	{
+		for (auto& byte : bytes)
+		{
+			byte = -1;
+		}
+		for (std::size_t i = 0; i < core::ArraySize(k_chars_table); ++i)
+		{
+			bytes[static_cast<unsigned char>(k_chars_table[i])] = static_cast<int>(i);
+		}
+	}
+};
+
+constexpr CharsToBytesTable k_chars_to_bytes;
+
 void SetOptionalFlag(bool* flag, bool value)
 {
 	if (flag)
@@ -50,14 +71,11 @@ char ByteToChar(Byte b, bool* converted /*= nullptr*/)
 
 Byte CharToByte(char ch, bool* converted /*= nullptr*/)
 {
-	// Can be replaced to table lookup also
-	const auto begin = std::cbegin(k_chars_table);
-	const auto end = std::cend(k_chars_table);
-	const auto it = std::find(begin, end, ch);
-	if (it != end)
+	const int byte = k_chars_to_bytes.bytes[static_cast<unsigned char>(ch)];
+	if (byte >= 0)
 	{
 		SetOptionalFlag(converted, true);
-		return std::distance(begin, it);
+		return byte;
 	}
 	
 	SetOptionalFlag(converted, false);
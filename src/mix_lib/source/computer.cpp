@@ -8,9 +8,32 @@
 #include "internal/helpers.hpp"
 
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
 
 using namespace mix;
 
+namespace {
+
+// MagneticTape [0; 7] and Drum [8; 15]
+const DeviceId k_binary_devices_count = 16;
+const int k_binary_device_block_size = 100;
+
+const struct
+{
+	const DeviceId id;
+	const int block_size;
+	const bool fill_new_line_with_spaces;
+} k_symbol_devices[] = {
+	{16, 16, false}, // PunchCard
+	{17, 16, false}, // Perforator
+	{18, 24, false}, // Printer
+	{19, 14, true}, // Terminal
+	{20, 14, false}, // PunchedTape
+};
+
+} // namespace
+
 Computer::Computer(IComputerListener* listener /*= nullptr*/)
 	: ra_{}
 	, rx_{}
@@ -20,12 +43,15 @@ Computer::Computer(IComputerListener* listener /*= nullptr*/)
 	, comparison_state_{ComparisonIndicator::Less}
 	, overflow_flag_{OverflowFlag::NoOverflow}
 	, memory_()
+	, memory_base_()
+	, dirty_pages_()
 	, devices_{listener}
 	, listener_{listener}
 	, halted_{false}
 	, had_jump_{false}
+	, error_()
 {
-	setup_default_devices();
+	setup_default_devices(std::cout, std::cin);
 }
 
 const Register& Computer::ra() const
@@ -85,6 +111,7 @@ void Computer::set_memory(int address, const Word& value)
 	}
 
 	memory_[static_cast<std::size_t>(address)] = value;
+	mark_memory_page_dirty(address);
 	internal::InvokeListener(listener_, &IComputerListener::on_memory_set, address);
 }
 
@@ -190,20 +217,21 @@ bool Computer::run_one()
 	{
 		return false;
 	}
-    
-    // #XXX: kill try/catch
-    try
-    {
-        execute(Command{memory(current_address())});
-        set_next_address(next_address());
-        // Be sure to jump only once
-        had_jump_ = false;
-    }
-    catch (const std::exception&)
-    {
-        halt();
-        return false;
-    }
+
+	// #XXX: kill try/catch
+	try
+	{
+		execute(Command{memory(current_address())});
+		set_next_address(next_address());
+		// Be sure to jump only once
+		had_jump_ = false;
+	}
+	catch (const std::exception&)
+	{
+		error_ = std::current_exception();
+		halt();
+		return false;
+	}
 
 	return true;
 }
@@ -218,6 +246,11 @@ bool Computer::is_halted() const
     return halted_;
 }
 
+std::exception_ptr Computer::error() const
+{
+	return error_;
+}
+
 IIODevice& Computer::device(DeviceId id)
 {
 	return devices_.device(id);
@@ -228,6 +261,11 @@ void Computer::replace_device(DeviceId id, std::unique_ptr<IIODevice> device)
 	devices_.inject_device(id, std::move(device));
 }
 
+void Computer::bind_devices(std::ostream& out, std::istream& in)
+{
+	setup_default_devices(out, in);
+}
+
 IIODevice& Computer::wait_device_ready(DeviceId id)
 {
 	auto& handle = device(id);
@@ -238,38 +276,109 @@ IIODevice& Computer::wait_device_ready(DeviceId id)
 	return handle;
 }
 
-void Computer::setup_default_devices()
+void Computer::setup_default_devices(std::ostream& out, std::istream& in)
 {
-	// MagneticTape [0; 7] and Drum [8; 15]
-	for (DeviceId id = 0; id <= 15; ++id)
+	for (DeviceId id = 0; id < k_binary_devices_count; ++id)
 	{
 		devices_.inject_device(id,
 			std::make_unique<BinaryDevice>(
-				100/*block size*/,
-				std::cout,
-				std::cin));
+				k_binary_device_block_size,
+				out,
+				in));
 	}
 
-	const struct
-	{
-		const DeviceId id;
-		const int block_size;
-		const bool fill_new_line_with_spaces;
-	} k_symbol_devices[] = {
-		{16, 16, false}, // PunchCard
-		{17, 16, false}, // Perforator
-		{18, 24, false}, // Printer
-		{19, 14, true}, // Terminal
-		{20, 14, false}, // PunchedTape
-	};
-
 	for (auto symbol_device : k_symbol_devices)
 	{
 		devices_.inject_device(symbol_device.id,
 			std::make_unique<SymbolDevice>(
 				symbol_device.block_size,
-				std::cout,
-				std::cin,
+				out,
+				in,
 				symbol_device.fill_new_line_with_spaces));
 	}
 }
+
+void Computer::mark_memory_page_dirty(int address)
+{
+	dirty_pages_.set(static_cast<std::size_t>(address) / ComputerSnapshot::k_page_words_count);
+}
+
+ComputerSnapshot Computer::snapshot()
+{
+	static_assert(std::tuple_size<decltype(ComputerSnapshot::rindexes_)>::value
+		== k_index_registers_count, "Snapshot should hold all index registers");
+
+	ComputerSnapshot snapshot;
+	snapshot.ra_ = ra_;
+	snapshot.rx_ = rx_;
+	snapshot.rindexes_ = rindexes_;
+	snapshot.rj_ = rj_;
+	snapshot.rip_ = rip_;
+	snapshot.comparison_state_ = comparison_state_;
+	snapshot.overflow_flag_ = overflow_flag_;
+	snapshot.halted_ = halted_;
+	snapshot.had_jump_ = had_jump_;
+
+	snapshot.pages_.reserve(k_memory_pages_count);
+	for (std::size_t i = 0; i < k_memory_pages_count; ++i)
+	{
+		auto& base = memory_base_[i];
+		if (!base || dirty_pages_.test(i))
+		{
+			const auto page_begin = memory_.cbegin() +
+				static_cast<std::ptrdiff_t>(i * ComputerSnapshot::k_page_words_count);
+			auto page = std::make_shared<ComputerSnapshot::MemoryPage>();
+			std::copy_n(page_begin, page->size(), page->begin());
+			base = std::move(page);
+		}
+		snapshot.pages_.push_back(base);
+	}
+	dirty_pages_.reset();
+
+	for (std::size_t id = 0; id < snapshot.devices_.size(); ++id)
+	{
+		snapshot.devices_[id] = devices_.device(static_cast<DeviceId>(id)).position();
+	}
+
+	return snapshot;
+}
+
+void Computer::restore(const ComputerSnapshot& snapshot)
+{
+	if (snapshot.empty())
+	{
+		throw std::logic_error("Restoring empty Computer snapshot");
+	}
+
+	ra_ = snapshot.ra_;
+	rx_ = snapshot.rx_;
+	rindexes_ = snapshot.rindexes_;
+	rj_ = snapshot.rj_;
+	rip_ = snapshot.rip_;
+	comparison_state_ = snapshot.comparison_state_;
+	overflow_flag_ = snapshot.overflow_flag_;
+	halted_ = snapshot.halted_;
+	had_jump_ = snapshot.had_jump_;
+	error_ = nullptr;
+
+	for (std::size_t i = 0; i < k_memory_pages_count; ++i)
+	{
+		const auto& page = snapshot.pages_[i];
+		auto& base = memory_base_[i];
+		if ((base == page) && !dirty_pages_.test(i))
+		{
+			continue;
+		}
+
+		const auto page_begin = memory_.begin() +
+			static_cast<std::ptrdiff_t>(i * ComputerSnapshot::k_page_words_count);
+		std::copy(page->cbegin(), page->cend(), page_begin);
+		base = page;
+	}
+	dirty_pages_.reset();
+
+	for (std::size_t id = 0; id < snapshot.devices_.size(); ++id)
+	{
+		devices_.device(static_cast<DeviceId>(id)).set_position(snapshot.devices_[id]);
+	}
+}
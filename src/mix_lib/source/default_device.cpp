@@ -11,18 +11,64 @@ namespace {
 // that something went wrong
 const char k_unknown_MIX_char = '@';
 
+// Only streams owned by the device are rewound: output that was
+// already given to the user (e.g., `std::cout` redirected to file)
+// should not be overwritten
+DevicePosition StreamsPosition(std::ostream* out, std::istream* in)
+{
+	DevicePosition position;
+	if (in)
+	{
+		position.input = static_cast<std::int64_t>(in->tellg());
+	}
+	if (out)
+	{
+		position.output = static_cast<std::int64_t>(out->tellp());
+	}
+	return position;
+}
+
+void SetStreamsPosition(std::ostream* out, std::istream* in, const DevicePosition& position)
+{
+	// Note: non-seekable streams report -1 position and are left untouched
+	if (in && (position.input >= 0))
+	{
+		in->clear();
+		in->seekg(static_cast<std::streamoff>(position.input));
+	}
+	if (out && (position.output >= 0))
+	{
+		out->clear();
+		out->seekp(static_cast<std::streamoff>(position.output));
+	}
+}
+
 } // namespace
 
 SymbolDevice::SymbolDevice(int block_size, std::ostream& out, std::istream& in,
 	bool handle_new_line /*= false*/)
 		: block_size_{block_size}
 		, current_column_{0}
+		, owned_out_{}
+		, owned_in_{}
 		, out_{out}
 		, in_{in}
 		, handle_new_line_{handle_new_line}
 {
 }
 
+SymbolDevice::SymbolDevice(int block_size, std::unique_ptr<std::ostream> out,
+	std::unique_ptr<std::istream> in, bool handle_new_line /*= false*/)
+		: block_size_{block_size}
+		, current_column_{0}
+		, owned_out_{std::move(out)}
+		, owned_in_{std::move(in)}
+		, out_{*owned_out_}
+		, in_{*owned_in_}
+		, handle_new_line_{handle_new_line}
+{
+}
+
 bool SymbolDevice::ready() const
 {
 	return true;
@@ -66,6 +112,19 @@ void SymbolDevice::write(DeviceBlockId /*block_id*/, Block&& block)
 	}
 }
 
+DevicePosition SymbolDevice::position() const
+{
+	auto position = StreamsPosition(owned_out_.get(), owned_in_.get());
+	position.column = current_column_;
+	return position;
+}
+
+void SymbolDevice::set_position(const DevicePosition& position)
+{
+	SetStreamsPosition(owned_out_.get(), owned_in_.get(), position);
+	current_column_ = position.column;
+}
+
 void SymbolDevice::write_word(const Word& word)
 {
 	for (auto byte : word.bytes())
@@ -136,11 +195,23 @@ Word SymbolDevice::word_with_all_spaces() const
 
 BinaryDevice::BinaryDevice(int block_size, std::ostream& out, std::istream& in)
 	: block_size_{block_size}
+	, owned_out_{}
+	, owned_in_{}
 	, out_{out}
 	, in_{in}
 {
 }
 
+BinaryDevice::BinaryDevice(int block_size, std::unique_ptr<std::ostream> out,
+	std::unique_ptr<std::istream> in)
+		: block_size_{block_size}
+		, owned_out_{std::move(out)}
+		, owned_in_{std::move(in)}
+		, out_{*owned_out_}
+		, in_{*owned_in_}
+{
+}
+
 bool BinaryDevice::ready() const
 {
 	return true;
@@ -176,6 +247,16 @@ void BinaryDevice::write(DeviceBlockId /*block_id*/, Block&& block)
 	}
 }
 
+DevicePosition BinaryDevice::position() const
+{
+	return StreamsPosition(owned_out_.get(), owned_in_.get());
+}
+
+void BinaryDevice::set_position(const DevicePosition& position)
+{
+	SetStreamsPosition(owned_out_.get(), owned_in_.get(), position);
+}
+
 void BinaryDevice::write_word(const Word& word)
 {
 	out_ << int{word.value()};
@@ -55,6 +55,16 @@ struct DeviceProxy final :
 		device_->write(block_id, std::move(block));
 	}
 
+	virtual DevicePosition position() const override
+	{
+		return device_->position();
+	}
+
+	virtual void set_position(const DevicePosition& position) override
+	{
+		device_->set_position(position);
+	}
+
 private:
 	IIODeviceListener* listener_;
 	std::unique_ptr<IIODevice> device_;
@@ -0,0 +1,221 @@
+#include <mix/file_device.h>
+#include <mix/exceptions.h>
+
+#include "internal/text_records.hpp"
+#include "internal/spsc_queue.hpp"
+
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+
+using namespace mix;
+
+struct FileReaderDevice::Impl
+{
+	Impl(int block_size, const std::string& file_path, std::size_t read_ahead_blocks);
+	~Impl();
+
+	Block blank_block() const;
+	void read_file();
+	bool push(Block&& block);
+	void finish(std::exception_ptr read_error);
+	// Wakes up other side waiting on `condition`. Mutex is taken,
+	// so the waiter either sees the change or is already waiting
+	void notify(std::condition_variable& condition);
+
+	const std::string file_path;
+	const int block_size;
+	std::ifstream file;
+	internal::SpscQueue<Block> queue;
+	// Producer pushed everything it could read.
+	// `error` is written before `finished` is set
+	std::atomic<bool> finished;
+	std::exception_ptr error;
+	std::atomic<bool> stop;
+	std::mutex mutex;
+	std::condition_variable not_full;
+	std::condition_variable not_empty;
+	std::thread reader;
+};
+
+FileReaderDevice::Impl::Impl(int block_size, const std::string& file_path,
+	std::size_t read_ahead_blocks)
+		: file_path{file_path}
+		, block_size{block_size}
+		, file{file_path, std::ios_base::binary}
+		, queue{read_ahead_blocks}
+		, finished{false}
+		, error()
+		, stop{false}
+		, mutex()
+		, not_full()
+		, not_empty()
+		, reader()
+{
+	if (!file)
+	{
+		throw DeviceFileOpenError{file_path};
+	}
+
+	reader = std::thread{&Impl::read_file, this};
+}
+
+FileReaderDevice::Impl::~Impl()
+{
+	stop = true;
+	notify(not_full);
+	reader.join();
+}
+
+FileReaderDevice::Block FileReaderDevice::Impl::blank_block() const
+{
+	Block block;
+	block.resize(static_cast<std::size_t>(block_size), internal::WordWithAllSpaces());
+	return block;
+}
+
+void FileReaderDevice::Impl::read_file()
+{
+	try
+	{
+		std::string line;
+		while (!stop && std::getline(file, line))
+		{
+			// Too long line continues in next record,
+			// empty line is a record of spaces
+			std::size_t position = 0;
+			do
+			{
+				auto block = blank_block();
+				position = internal::DecodeTextRecord(line, position, block);
+				if (!push(std::move(block)))
+				{
+					return;
+				}
+			}
+			while (position < line.size());
+		}
+
+		if (file.bad())
+		{
+			throw DeviceFileReadError{file_path};
+		}
+	}
+	catch (...)
+	{
+		// Blocks read so far are still handed out,
+		// `read()` throws the error after them
+		finish(std::current_exception());
+		return;
+	}
+	finish(nullptr);
+}
+
+bool FileReaderDevice::Impl::push(Block&& block)
+{
+	if (!queue.try_push(std::move(block)))
+	{
+		std::unique_lock<std::mutex> lock{mutex};
+		not_full.wait(lock, [&]()
+		{
+			return stop || queue.try_push(std::move(block));
+		});
+		if (stop)
+		{
+			return false;
+		}
+	}
+	notify(not_empty);
+	return true;
+}
+
+void FileReaderDevice::Impl::finish(std::exception_ptr read_error)
+{
+	error = std::move(read_error);
+	finished.store(true, std::memory_order_release);
+	notify(not_empty);
+}
+
+void FileReaderDevice::Impl::notify(std::condition_variable& condition)
+{
+	{
+		std::lock_guard<std::mutex> lock{mutex};
+	}
+	condition.notify_one();
+}
+
+FileReaderDevice::FileReaderDevice(int block_size, const std::string& file_path,
+	std::size_t read_ahead_blocks /*= k_default_read_ahead_blocks*/)
+		: impl_{std::make_unique<Impl>(block_size, file_path, read_ahead_blocks)}
+{
+}
+
+FileReaderDevice::~FileReaderDevice() = default;
+
+bool FileReaderDevice::ready() const
+{
+	return !impl_->queue.empty()
+		|| impl_->finished.load(std::memory_order_acquire);
+}
+
+int FileReaderDevice::block_size() const
+{
+	return impl_->block_size;
+}
+
+FileReaderDevice::Block FileReaderDevice::prepare_block() const
+{
+	return impl_->blank_block();
+}
+
+FileReaderDevice::Block FileReaderDevice::read(DeviceBlockId /*block_id*/)
+{
+	Block block;
+	if (!impl_->queue.try_pop(block))
+	{
+		bool popped = false;
+		{
+			std::unique_lock<std::mutex> lock{impl_->mutex};
+			impl_->not_empty.wait(lock, [&]()
+			{
+				popped = impl_->queue.try_pop(block);
+				return popped || impl_->finished.load(std::memory_order_acquire);
+			});
+			// Producer could push last block right before finishing
+			popped = popped || impl_->queue.try_pop(block);
+		}
+
+		if (!popped)
+		{
+			if (impl_->error)
+			{
+				std::rethrow_exception(impl_->error);
+			}
+			return prepare_block();
+		}
+	}
+
+	impl_->notify(impl_->not_full);
+	return block;
+}
+
+void FileReaderDevice::write(DeviceBlockId /*block_id*/, Block&& /*block*/)
+{
+}
+
+namespace mix {
+
+std::unique_ptr<IIODevice> MakeCardReaderDevice(const std::string& file_path)
+{
+	return std::make_unique<FileReaderDevice>(16, file_path);
+}
+
+std::unique_ptr<IIODevice> MakePaperTapeReaderDevice(const std::string& file_path)
+{
+	return std::make_unique<FileReaderDevice>(14, file_path);
+}
+
+} // namespace mix
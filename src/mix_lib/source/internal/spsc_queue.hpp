@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <utility>
+
+#include <cstddef>
+#include <cassert>
+
+namespace mix {
+namespace internal {
+
+// Bounded lock-free queue for exactly one producer thread
+// and exactly one consumer thread (ring buffer)
+template<typename T>
+class SpscQueue
+{
+public:
+	explicit SpscQueue(std::size_t capacity)
+		// One slot is always kept empty to tell full queue from empty one
+		: items_(capacity + 1)
+		, head_{0}
+		, tail_{0}
+	{
+		assert(capacity > 0);
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	// Producer side. Returns false if queue is full
+	bool try_push(T&& value)
+	{
+		const std::size_t tail = tail_.load(std::memory_order_relaxed);
+		const std::size_t next = increment(tail);
+		if (next == head_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		items_[tail] = std::move(value);
+		tail_.store(next, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer side. Returns false if queue is empty
+	bool try_pop(T& value)
+	{
+		const std::size_t head = head_.load(std::memory_order_relaxed);
+		if (head == tail_.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		value = std::move(items_[head]);
+		head_.store(increment(head), std::memory_order_release);
+		return true;
+	}
+
+	// Consumer side
+	bool empty() const
+	{
+		return (head_.load(std::memory_order_relaxed)
+			== tail_.load(std::memory_order_acquire));
+	}
+
+private:
+	std::size_t increment(std::size_t index) const
+	{
+		return ((index + 1) == items_.size()) ? 0 : (index + 1);
+	}
+
+private:
+	std::vector<T> items_;
+	std::atomic<std::size_t> head_;
+	std::atomic<std::size_t> tail_;
+};
+
+} // namespace internal
+} // namespace mix
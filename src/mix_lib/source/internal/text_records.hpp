@@ -0,0 +1,60 @@
+#pragma once
+#include <mix/word.h>
+#include <mix/char_table.h>
+
+#include <core/string.h>
+
+#include <vector>
+
+namespace mix {
+namespace internal {
+
+inline Word WordWithAllSpaces()
+{
+	Word::BytesArray bytes;
+	bytes.fill(CharToByte(' '));
+	return Word(std::move(bytes));
+}
+
+inline bool IsLineBreak(char ch)
+{
+	return (ch == '\n') || (ch == '\r');
+}
+
+inline std::size_t SkipLineBreak(std::string_view text, std::size_t position)
+{
+	if ((position < text.size()) && (text[position] == '\r'))
+	{
+		++position;
+	}
+	if ((position < text.size()) && (text[position] == '\n'))
+	{
+		++position;
+	}
+	return position;
+}
+
+// Decodes MIX characters from `text` (starting at `position`) into `block`
+// words, until block is filled or line break is met (line break is skipped
+// in both cases). Not filled part of the block is left untouched.
+// Returns position of next record
+inline std::size_t DecodeTextRecord(std::string_view text, std::size_t position,
+	std::vector<Word>& block)
+{
+	for (auto& word : block)
+	{
+		for (std::size_t i = 1; i <= Word::k_bytes_count; ++i)
+		{
+			if ((position >= text.size()) || IsLineBreak(text[position]))
+			{
+				return SkipLineBreak(text, position);
+			}
+			word.set_byte(i, CharToByte(text[position]));
+			++position;
+		}
+	}
+	return SkipLineBreak(text, position);
+}
+
+} // namespace internal
+} // namespace mix
@@ -3,9 +3,12 @@
 #include <mix/exceptions.h>
 
 #include <iostream>
+#include <utility>
 
-template<typename Callable>
-void HandleAnyException(Callable callable)
+// `before_report` is called before error is written to std::cerr
+// (e.g., to write buffered output, so it goes before the error)
+template<typename Callable, typename BeforeReport>
+void HandleAnyException(Callable callable, BeforeReport before_report)
 {
 	try
 	{
@@ -13,20 +16,30 @@ void HandleAnyException(Callable callable)
 	}
 	catch (const mixal::MixalException& mixal_error)
 	{
+		before_report();
 		std::cerr << "[MIXAL] Error: " << mixal_error.what() << "\n";
 	}
 	catch (const mix::MixException& mix_error)
 	{
+		before_report();
 		std::cerr << "[MIX] Error: " << mix_error.what() << "\n";
 	}
 	catch (const std::exception& e)
 	{
+		before_report();
 		std::cerr << "Error: " << e.what() << "\n";
 	}
 	catch (...)
 	{
+		before_report();
 		std::cerr << "Error: " << "UNKNOWN" << "\n";
 	}
 }
 
+template<typename Callable>
+void HandleAnyException(Callable callable)
+{
+	HandleAnyException(std::move(callable), []() {});
+}
+
 
@@ -1,14 +1,18 @@
 #pragma once
 #include <mixal/options.h>
-#include <mixal/optional_stream.h>
+#include <mixal/listing_writer.h>
 #include <mixal/exceptions_handler.h>
 
 #include <mixal/line_translator.h>
+#include <mixal/source_buffer.h>
 #include <mixal/translator.h>
 #include <mixal/exceptions.h>
 #include <mixal/program_executor.h>
 
 #include <mixal_parse/line_parser.h>
+#include <mixal_parse/parsed_lines_stream.h>
+
+#include <core/line_reader.h>
 
 #include <mix/command.h>
 
@@ -16,11 +20,17 @@
 
 #include <cassert>
 
-#include <list>
 #include <string>
-#include <iomanip>
 #include <fstream>
 
+#include <cstdio>
+
+#if defined(_WIN32)
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
 namespace mixal {
 
 namespace parse = mixal_parse;
@@ -29,16 +39,23 @@ namespace parse = mixal_parse;
 class Interpreter
 {
 public:
-	Interpreter(std::ostream& out, bool show_details);
+	// See `ListingWriter` for `flush_lines`
+	Interpreter(std::ostream& out, bool show_details,
+		LiteralsPooling literals_pooling = LiteralsPooling::Disabled,
+		bool flush_lines = false);
 
-	void translate_line(const std::string& str);
+	// `line.text` is not copied and should outlive `Interpreter`
+	void translate_parsed_line(const parse::ParsedLine& line);
+	// `line` is not copied and should outlive `Interpreter`
+	void translate_line_in_place(std::string_view line);
 
 	int printed_commands_count() const;
+	// Writes buffered listing to the output stream
+	void flush();
 
 private:
 	std::size_t lines_number() const;
 
-	std::string_view prepare_line(const std::string& line);
 	void add_translated_line(OperationId command, TranslatedLine&& line);
 
 	void add_translated_word(OperationId command,
@@ -61,16 +78,21 @@ private:
 private:
 	using DelayedWords = FlatMap<FutureTranslatedWordRef, OperationId>;
 
-	OptionalOStream out_;
+	ListingWriter out_;
 	Translator translator_;
 	DelayedWords delayed_words_;
 
-	std::list<std::string> code_lines_;
+	std::size_t lines_count_;
 	int printed_commands_count_;
 };
 
+// Standard output is a terminal, so listing should be shown line by line
+bool IsInteractiveOutput();
 int RunInterpreter(Options options);
-void TranslateStream(Interpreter& interpreter, std::istream& in);
+// Lines of `reader` should outlive `interpreter`
+// (see `core::LinesLifetime::WhileReaderIsAlive`)
+void TranslateStream(Interpreter& interpreter, core::LineReader& reader);
+void TranslateSource(Interpreter& interpreter, const SourceBuffer& source);
 
 } // namespace mixal
 
@@ -78,25 +100,33 @@ void TranslateStream(Interpreter& interpreter, std::istream& in);
 
 namespace mixal {
 
-inline Interpreter::Interpreter(std::ostream& out, bool show_details)
-	: out_{out, show_details}
+inline Interpreter::Interpreter(std::ostream& out, bool show_details,
+	LiteralsPooling literals_pooling /*= LiteralsPooling::Disabled*/,
+	bool flush_lines /*= false*/)
+	: out_{out, show_details, flush_lines}
 	, translator_{}
 	, delayed_words_{}
-	, code_lines_{}
+	, lines_count_{0}
 	, printed_commands_count_{0}
 {
+	translator_.set_literals_pooling(literals_pooling);
 }
 
 inline std::size_t Interpreter::lines_number() const
 {
-	return code_lines_.size();
+	return lines_count_;
 }
 
-int Interpreter::printed_commands_count() const
+inline int Interpreter::printed_commands_count() const
 {
 	return printed_commands_count_;
 }
 
+inline void Interpreter::flush()
+{
+	out_.flush();
+}
+
 inline void Interpreter::save_delayed_word(OperationId command,
 	FutureTranslatedWordRef translated)
 {
@@ -124,9 +154,11 @@ inline void Interpreter::print_translated_word_details(OperationId command,
 
 	for (const auto& ref : translated->forward_references)
 	{
-		out_ << "`" << ref.name() << "`, ";
+		out_.write_details("`");
+		out_.write_details(ref.name());
+		out_.write_details("`, ");
 	}
-	out_ << "\n";
+	out_.write_details("\n");
 }
 
 inline void Interpreter::add_translated_word(OperationId command,
@@ -144,9 +176,10 @@ inline void Interpreter::print_end_command_details(OperationId command,
 		print_code(command, symbol_code.second);
 	}
 
-	out_ << "\n";
+	out_.write_details("\n");
 	print_details("start address: ");
-	out_ << end_code.start_address << "\n";
+	out_.write_details(end_code.start_address);
+	out_.write_details("\n");
 }
 
 inline void Interpreter::add_translated_line(OperationId command, TranslatedLine&& line)
@@ -192,46 +225,31 @@ inline void Interpreter::print_code(OperationId command, const TranslatedWord& w
 		print_details(details_text);
 	}
 
-	out_ << std::setw(3) << lines_number() << "| ";
-	out_.stream << std::setw(4) << std::right << word.original_address << ": ";
-
-	const auto prev_fill = out_.stream.fill('0');
+	out_.write_line_number(lines_number(), '|');
+	out_.write_address(word.original_address);
 
 	switch (command)
 	{
 	case OperationId::CON:
 	case OperationId::END:
-		out_.stream.fill(' ');
-		out_.stream << '|' << word.value.sign() << '|' << std::setw(14)
-			<< std::right << word.value.abs_value() << '|' << "\n";
+		out_.write_value(word.value);
 		break;
 	case OperationId::ALF:
-        out_.stream << word.value << "\n";
+		out_.write_bytes(word.value);
 		break;
 	default:
-		out_.stream << mix::Command{word.value} << "\n";
+		out_.write_command(mix::Command{word.value});
 		break;
 	}
 
-	out_.stream.fill(prev_fill);
-
 	++printed_commands_count_;
 }
 
 inline void Interpreter::print_details(const char* details_text)
 {
 	assert(details_text);
-	out_ << std::setw(3) << lines_number() << "> " << details_text;
-}
-
-inline std::string_view Interpreter::prepare_line(const std::string& line)
-{
-	// Small hack to prevent working with dead strings later
-	// (Parser works with `std::string_view` and `Translator` gives 
-	// unresolved symbol names that refer to parsed string)
-	// #TODO: think is there better way to deal with it
-	code_lines_.push_back(line);
-	return code_lines_.back();
+	out_.write_line_number(lines_number(), '>');
+	out_.write_details(details_text);
 }
 
 inline OperationId Interpreter::LineOperationId(const parse::LineParser& parser)
@@ -244,14 +262,32 @@ inline OperationId Interpreter::LineOperationId(const parse::LineParser& parser)
 	return OperationId::Unknown;
 }
 
-inline void Interpreter::translate_line(const std::string& str)
+inline void Interpreter::translate_parsed_line(const parse::ParsedLine& line)
 {
-	if (core::Trim(str).empty())
+	if (line.is_empty())
 	{
 		return;
 	}
 
-	const auto line = prepare_line(str);
+	++lines_count_;
+	if (!line.parser)
+	{
+		throw MixalException{"parse error"};
+	}
+
+	add_translated_line(
+		LineOperationId(*line.parser),
+		TranslateLine(translator_, *line.parser));
+}
+
+inline void Interpreter::translate_line_in_place(std::string_view line)
+{
+	if (core::Trim(line).empty())
+	{
+		return;
+	}
+
+	++lines_count_;
 	parse::LineParser parser;
 	const auto pos = parser.parse_stream(line);
 	if (parse::IsInvalidStreamPosition(pos))
@@ -264,30 +300,71 @@ inline void Interpreter::translate_line(const std::string& str)
 		TranslateLine(translator_, parser));
 }
 
-inline void TranslateStream(Interpreter& interpreter, std::istream& in)
+inline void TranslateStream(Interpreter& interpreter, core::LineReader& reader)
 {
-	std::string line;
-	while (getline(in, line))
+	parse::ParsedLinesStream lines{reader};
+	parse::ParsedLine line;
+	while (lines.next(line))
 	{
 		HandleAnyException([&]()
 		{
-			interpreter.translate_line(line);
+			interpreter.translate_parsed_line(line);
+		}, [&]()
+		{
+			// Listing of previous lines goes before the error
+			interpreter.flush();
 		});
+		if (!reader.has_buffered_input())
+		{
+			// Show listing before waiting for the next line
+			interpreter.flush();
+		}
 	}
 }
 
-inline int RunInterpreter(Options options)
+inline void TranslateSource(Interpreter& interpreter, const SourceBuffer& source)
 {
-	Interpreter interpreter{std::cout, !options.hide_details};
-	if (options.file_name.empty())
+	for (std::string_view line : source.lines())
 	{
-		TranslateStream(interpreter, std::cin);
+		HandleAnyException([&]()
+		{
+			interpreter.translate_line_in_place(line);
+		}, [&]()
+		{
+			interpreter.flush();
+		});
 	}
-	else
+}
+
+inline bool IsInteractiveOutput()
+{
+#if defined(_WIN32)
+	return (::_isatty(::_fileno(stdout)) != 0);
+#else
+	return (::isatty(::fileno(stdout)) != 0);
+#endif
+}
+
+inline int RunInterpreter(Options options)
+{
+	const bool flush_lines = IsInteractiveOutput();
+	if (options.file_name.empty())
 	{
-		std::ifstream input_file(options.file_name);
-		TranslateStream(interpreter, input_file);
+		// Lines should outlive interpreter. Standard input is read
+		// directly, chunks are as big as available input is
+		core::LineReader reader{core::ByteSource::FromFileDescriptor(0),
+			core::LinesLifetime::WhileReaderIsAlive};
+		Interpreter interpreter{std::cout, !options.hide_details,
+			options.literals_pooling, flush_lines};
+		TranslateStream(interpreter, reader);
+		return interpreter.printed_commands_count();
 	}
+
+	// Source should outlive interpreter
+	const auto source = SourceBuffer::FromFile(options.file_name);
+	Interpreter interpreter{std::cout, !options.hide_details,
+		options.literals_pooling, flush_lines};
+	TranslateSource(interpreter, source);
 	return interpreter.printed_commands_count();
 }
 
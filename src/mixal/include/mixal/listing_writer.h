@@ -0,0 +1,216 @@
+#pragma once
+#include <mix/command.h>
+#include <mix/word.h>
+
+#include <core/string.h>
+
+#include <ostream>
+#include <string>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mixal {
+
+// Listing of interactive compile. Records are formatted by hand into
+// single big buffer that is written to the stream in bulk (when it's full
+// or on `flush()`). Output is the same as `std::ostream` gives
+// with `std::setw()`/`std::setfill()` for the same record.
+// Details (line numbers, notes) are written only when `show_details` is set.
+// With `flush_lines` every finished line is written (and flushed) at once,
+// e.g. when output is a terminal
+class ListingWriter
+{
+public:
+	static constexpr std::size_t k_buffer_size = 64 * 1024;
+
+	ListingWriter(std::ostream& out, bool show_details, bool flush_lines = false);
+	~ListingWriter();
+
+	ListingWriter(const ListingWriter&) = delete;
+	ListingWriter& operator=(const ListingWriter&) = delete;
+
+	// "%3zu| " (or with other separator)
+	void write_line_number(std::size_t line_number, char separator);
+	void write_details(std::string_view text);
+	void write_details(long long value);
+
+	// "%4d: "
+	void write_address(int address);
+	// "|+|%14zu|\n"
+	void write_value(const mix::Word& word);
+	// "|+|%02d|%02d|%02d|%02d|%02d|\n"
+	void write_bytes(const mix::Word& word);
+	// "|+| %04d|%02zu|%02zu|%02zu|\n"
+	void write_command(const mix::Command& command);
+
+	// Writes buffered records and flushes the stream
+	void flush();
+
+private:
+	void append(std::string_view text);
+	void append(char ch);
+	// Right-aligned, as with `std::right`: fill goes before the sign
+	void append_number(long long value, std::size_t width, char fill);
+	void append_sign(mix::Sign sign);
+
+private:
+	std::ostream& out_;
+	bool show_details_;
+	bool flush_lines_;
+	std::string buffer_;
+};
+
+} // namespace mixal
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace mixal {
+
+inline ListingWriter::ListingWriter(std::ostream& out, bool show_details,
+	bool flush_lines /*= false*/)
+	: out_{out}
+	, show_details_{show_details}
+	, flush_lines_{flush_lines}
+	, buffer_{}
+{
+	buffer_.reserve(k_buffer_size);
+}
+
+inline ListingWriter::~ListingWriter()
+{
+	flush();
+}
+
+inline void ListingWriter::write_line_number(std::size_t line_number, char separator)
+{
+	if (show_details_)
+	{
+		append_number(static_cast<long long>(line_number), 3, ' ');
+		append(separator);
+		append(' ');
+	}
+}
+
+inline void ListingWriter::write_details(std::string_view text)
+{
+	if (show_details_)
+	{
+		append(text);
+	}
+}
+
+inline void ListingWriter::write_details(long long value)
+{
+	if (show_details_)
+	{
+		append_number(value, 0, ' ');
+	}
+}
+
+inline void ListingWriter::write_address(int address)
+{
+	append_number(address, 4, ' ');
+	append(": ");
+}
+
+inline void ListingWriter::write_value(const mix::Word& word)
+{
+	append('|');
+	append_sign(word.sign());
+	append('|');
+	append_number(static_cast<long long>(word.abs_value()), 14, ' ');
+	append("|\n");
+}
+
+inline void ListingWriter::write_bytes(const mix::Word& word)
+{
+	append('|');
+	append_sign(word.sign());
+	append('|');
+	for (const auto& byte : word.bytes())
+	{
+		append_number(byte.value(), 2, '0');
+		append('|');
+	}
+	append('\n');
+}
+
+inline void ListingWriter::write_command(const mix::Command& command)
+{
+	append('|');
+	append_sign(command.sign());
+	append("| ");
+	const int address = command.address();
+	append_number((address < 0) ? -address : address, 4, '0');
+	append('|');
+	append_number(static_cast<long long>(command.address_index()), 2, '0');
+	append('|');
+	append_number(static_cast<long long>(command.field()), 2, '0');
+	append('|');
+	append_number(static_cast<long long>(command.id()), 2, '0');
+	append("|\n");
+}
+
+inline void ListingWriter::flush()
+{
+	if (!buffer_.empty())
+	{
+		out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+		buffer_.clear();
+	}
+	out_.flush();
+}
+
+inline void ListingWriter::append(std::string_view text)
+{
+	if ((buffer_.size() + text.size()) > k_buffer_size)
+	{
+		flush();
+	}
+	buffer_.append(text.data(), text.size());
+	if (flush_lines_ && !text.empty() && (text.back() == '\n'))
+	{
+		flush();
+	}
+}
+
+inline void ListingWriter::append(char ch)
+{
+	append(std::string_view{&ch, 1});
+}
+
+inline void ListingWriter::append_number(long long value, std::size_t width, char fill)
+{
+	char digits[24];
+	char* const end = digits + sizeof(digits);
+	char* begin = end;
+
+	auto abs_value = (value < 0)
+		? (0 - static_cast<std::uint64_t>(value))
+		: static_cast<std::uint64_t>(value);
+	do
+	{
+		*--begin = static_cast<char>('0' + (abs_value % 10));
+		abs_value /= 10;
+	}
+	while (abs_value != 0);
+	if (value < 0)
+	{
+		*--begin = '-';
+	}
+
+	const auto length = static_cast<std::size_t>(end - begin);
+	for (std::size_t i = length; i < width; ++i)
+	{
+		append(fill);
+	}
+	append(std::string_view{begin, length});
+}
+
+inline void ListingWriter::append_sign(mix::Sign sign)
+{
+	append((sign == mix::Sign::Positive) ? '+' : '-');
+}
+
+} // namespace mixal
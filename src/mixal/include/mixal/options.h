@@ -14,6 +14,9 @@
 #  pragma clang diagnostic pop
 #endif
 
+#include <mixal/translator.h>
+
+#include <stdexcept>
 #include <string>
 
 struct Options
@@ -25,6 +28,10 @@ struct Options
 	std::string file_name;
 	bool mdk_stream{false};
 	bool interactive_compile{false};
+	bool check{false};
+	std::string cache_dir;
+	std::string mdk_output_file;
+	mixal::LiteralsPooling literals_pooling{mixal::LiteralsPooling::Disabled};
 
 	Options(cxxopts::Options options)
 		: raw_options{std::move(options)}
@@ -39,12 +46,29 @@ inline cxxopts::Options CreateOptions()
 		("h,help",			"Show this help and exit")
 		("e,execute",		"Compile and execute file with MIXAL code")
 		("i,interactive",	"Compile MIXAL code line by line and print formatted MIX byte-code")
+		("check",			"Compile <file> and report all errors with line and column, do not execute")
 		("x,hide-details",	"Hide additional information during interactive compile")
 		("f,file",			"Input file (either MIXAL code or MIX byte-code)", cxxopts::value<std::string>())
-		("m,mdk",			"Interpret <file> as file with GNU MIX Development Kit (MDK) format");
+		("m,mdk",			"Interpret <file> as file with GNU MIX Development Kit (MDK) format")
+		("c,cache",			"Directory with translated programs, unchanged <file> is not translated again", cxxopts::value<std::string>())
+		("o,output-mdk",	"Compile <file> and save MIX byte-code in MDK format to given file", cxxopts::value<std::string>())
+		("p,pool-literals",	"Single word for literal constants with the same value (`same`), also reuse CON words with that value (`con`)", cxxopts::value<std::string>());
 		return options;
 }
 
+inline mixal::LiteralsPooling ParseLiteralsPooling(const std::string& value)
+{
+	if (value == "same")
+	{
+		return mixal::LiteralsPooling::SameValues;
+	}
+	else if (value == "con")
+	{
+		return mixal::LiteralsPooling::SameValuesAndCON;
+	}
+	throw std::runtime_error{"unknown literals pooling: " + value};
+}
+
 inline Options ParseOptions(int argc, char* argv[])
 {
 	Options parsed{CreateOptions()};
@@ -55,13 +79,30 @@ inline Options ParseOptions(int argc, char* argv[])
 	parsed.show_help = (options.count("help") > 0);
 	parsed.mdk_stream = (options.count("mdk") > 0);
 	parsed.interactive_compile = (options.count("interactive") > 0);
+	parsed.check = (options.count("check") > 0);
 	const auto& file_name_option = options["file"];
 	if (file_name_option.count() > 0)
 	{
 		parsed.file_name = file_name_option.as<std::string>();
 	}
+	const auto& cache_option = options["cache"];
+	if (cache_option.count() > 0)
+	{
+		parsed.cache_dir = cache_option.as<std::string>();
+	}
+	const auto& mdk_output_option = options["output-mdk"];
+	if (mdk_output_option.count() > 0)
+	{
+		parsed.mdk_output_file = mdk_output_option.as<std::string>();
+	}
+
+	const auto& pooling_option = options["pool-literals"];
+	if (pooling_option.count() > 0)
+	{
+		parsed.literals_pooling = ParseLiteralsPooling(pooling_option.as<std::string>());
+	}
 
-	if (!parsed.interactive_compile && !parsed.execute)
+	if (!parsed.interactive_compile && !parsed.execute && !parsed.check)
 	{
 		parsed.execute = true;
 	}
@@ -1,7 +1,10 @@
 #include <mixal/interpreter.h>
 #include <mixal/program_executor.h>
+#include <mixal/parallel_translator.h>
+#include <mixal/program_image.h>
 #include <mixal/exceptions_handler.h>
 #include <mixal/mdk_program_loader.h>
+#include <mixal/diagnostics.h>
 
 #include <fstream>
 
@@ -25,10 +28,17 @@ namespace
                 std::ifstream input(options.file_name, std::ios_base::binary);
                 program = ParseProgramFromMDKStream(input);
             }
+            else if (!options.cache_dir.empty())
+            {
+                program = LoadOrTranslateProgramImage(SourceBuffer::FromFile(options.file_name),
+                    options.cache_dir, options.literals_pooling).program;
+            }
             else
             {
-                std::ifstream input(options.file_name);
-                program = TranslateProgram(input);
+                ParallelTranslateOptions translate_options;
+                translate_options.literals_pooling = options.literals_pooling;
+                program = TranslateProgramParallel(
+                    SourceBuffer::FromFile(options.file_name), translate_options);
             }
 
             commands_count = ExecuteProgram(program);
@@ -37,15 +47,86 @@ namespace
         return commands_count;
     }
 
-	void RunWithOptions(Options options)
+    int CompileToMDK(const Options& options)
+    {
+        if (options.file_name.empty())
+        {
+            return -1;
+        }
+
+        int words_count = -1;
+        HandleAnyException([&]()
+        {
+            const auto image = TranslateProgramImage(
+                SourceBuffer::FromFile(options.file_name), options.literals_pooling);
+
+            MDKProgram mdk_program;
+            mdk_program.program = image.program;
+            mdk_program.lines = image.lines;
+            mdk_program.source_path = options.file_name;
+            for (const auto& symbol : image.symbols)
+            {
+                mdk_program.symbols.push_back(std::make_pair(
+                    symbol.first, static_cast<long>(symbol.second.value().value())));
+            }
+
+            std::ofstream output(options.mdk_output_file, std::ios_base::binary);
+            WriteMDKProgram(output, mdk_program);
+            if (!output.flush())
+            {
+                throw std::runtime_error{"failed to write " + options.mdk_output_file};
+            }
+            words_count = static_cast<int>(image.program.commands.size());
+        });
+
+        return words_count;
+    }
+
+    // Returns count of errors
+    int CheckProgram(const Options& options)
+    {
+        if (options.file_name.empty())
+        {
+            return -1;
+        }
+
+        int errors_count = -1;
+        HandleAnyException([&]()
+        {
+            Diagnostics diagnostics;
+            TranslateProgram(SourceBuffer::FromFile(options.file_name), diagnostics);
+            for (const auto& diagnostic : diagnostics.all())
+            {
+                std::cerr << options.file_name << ":" << ToString(diagnostic) << "\n";
+            }
+            errors_count = static_cast<int>(diagnostics.size());
+        });
+
+        return errors_count;
+    }
+
+	// Returns exit code of the process
+	int RunWithOptions(Options options)
 	{
 		if (options.show_help)
 		{
 			std::cout << options.raw_options.help() << '\n';
-			return;
+			return 0;
 		}
 
-		if (options.execute)
+		if (!options.mdk_output_file.empty())
+		{
+			const int words_count = CompileToMDK(options);
+			std::cout << "Written words count: " << words_count << '\n';
+		}
+		else if (options.check)
+		{
+			const int errors_count = CheckProgram(options);
+			std::cout << "Errors count: " << errors_count << '\n';
+			// -1 when the file can't be checked at all
+			return ((errors_count == 0) ? 0 : 1);
+		}
+		else if (options.execute)
 		{
 			const int commands_count = RunProgram(std::move(options));
 			std::cout << "Executed commands count: " << commands_count << '\n';
@@ -55,6 +136,7 @@ namespace
 			const int commands_count = RunInterpreter(std::move(options));
 			std::cout << "Commands count: " << commands_count << '\n';
 		}
+		return 0;
 	}
 } // namespace
 
@@ -62,8 +144,7 @@ int main(int argc, char* argv[])
 {
 	try
 	{
-		RunWithOptions(ParseOptions(argc, argv));
-		return 0;
+		return RunWithOptions(ParseOptions(argc, argv));
 	}
 	catch (const std::exception& e)
 	{
@@ -0,0 +1,72 @@
+#pragma once
+#include <mixal/config.h>
+#include <mixal/line_translator.h>
+#include <mixal/source_buffer.h>
+
+#include <mix/computer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace mixal {
+
+// Keeps translation state of the last assembled MIXAL source, so next version
+// of the source (e.g., after edit in the UI) is translated again only for
+// changed lines. Whole source is assembled from scratch when edit can change
+// layout of the program or value of any symbol: lines are added or removed,
+// changed line has EQU, ORIG, END, literal constant or other label
+class MIXAL_LIB_EXPORT AssemblerSession
+{
+public:
+	struct AssembledLine
+	{
+		OperationId operation_id{OperationId::Unknown};
+		// Range of words in `program().commands`.
+		// Empty for lines without words (comments, EQU, ...)
+		std::size_t first_word{0};
+		std::size_t words_count{0};
+	};
+
+	struct Result
+	{
+		// Whole source was assembled, all words of `program()` are new
+		bool full_assembly{true};
+		// Words of changed lines (valid when `full_assembly` is false)
+		std::vector<TranslatedWord> patched_words;
+	};
+
+public:
+	AssemblerSession();
+	~AssemblerSession();
+
+	AssemblerSession(AssemblerSession&&) noexcept;
+	AssemblerSession& operator=(AssemblerSession&&) noexcept;
+
+	// Throws the same as `TranslateProgram()`. After error,
+	// next `assemble()` translates whole source
+	Result assemble(std::string text);
+
+	// Loads whole program when `result.full_assembly` is true,
+	// otherwise only patched words are written to memory.
+	// Next address is set to start address of the program
+	void apply(mix::Computer& computer, const Result& result) const;
+
+	// Forgets previous source, next `assemble()` translates whole source
+	void reset();
+
+	const TranslatedProgram& program() const;
+	// Lines of the source up to END (inclusive)
+	const std::vector<AssembledLine>& lines() const;
+	// Source of the last successful `assemble()`
+	// (empty after error or `reset()`)
+	const SourceBuffer& source() const;
+
+private:
+	struct Impl;
+	std::unique_ptr<Impl> impl;
+};
+
+} // namespace mixal
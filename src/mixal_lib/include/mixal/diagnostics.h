@@ -0,0 +1,54 @@
+#pragma once
+#include <mixal/config.h>
+#include <mixal/line_translator.h>
+#include <mixal/source_buffer.h>
+
+#include <string>
+#include <vector>
+
+#include <cstddef>
+
+namespace mixal {
+
+struct Diagnostic
+{
+	// Starting from 1
+	std::size_t line{0};
+	// Starting from 1, 0 when position in the line is unknown
+	std::size_t column{0};
+	// Name of the symbol error is about (if any)
+	std::string symbol;
+	std::string message;
+};
+
+class MIXAL_LIB_EXPORT Diagnostics
+{
+public:
+	void add(Diagnostic diagnostic);
+
+	bool empty() const;
+	std::size_t size() const;
+	const std::vector<Diagnostic>& all() const;
+
+private:
+	std::vector<Diagnostic> diagnostics_;
+};
+
+// "<line>:<column>: error: <message> `<symbol>`"
+MIXAL_LIB_EXPORT
+std::string ToString(const Diagnostic& diagnostic);
+
+// Same as `TranslateProgram()`, but does not stop on the first error.
+// Parse and translation errors are added to `diagnostics` and translation
+// continues: invalid line that should generate a word gets zero word
+// at its address (and its label is defined), so addresses and symbols
+// of next lines are the same as without the error.
+// Errors of forward references resolution and of literal constants
+// (found only when the symbol is defined or on END) are reported for
+// the line that refers to them. Source without END gets "missing END"
+// at its last line. Diagnostics are ordered by lines.
+// Program is not valid when `diagnostics` are not empty
+MIXAL_LIB_EXPORT
+TranslatedProgram TranslateProgram(const SourceBuffer& source, Diagnostics& diagnostics);
+
+} // namespace mixal
@@ -0,0 +1,81 @@
+#pragma once
+#include <mixal/config.h>
+#include <mixal/line_translator.h>
+
+#include <ostream>
+#include <utility>
+#include <string>
+#include <vector>
+
+namespace mixal {
+
+// Commands that are executed one after another,
+// only the last one can transfer control
+struct BasicBlock
+{
+	int begin_address{0};
+	// Address after the last command of the block
+	int end_address{0};
+	// Begin addresses of blocks that can be executed next (sorted)
+	std::vector<int> successors;
+	// Last command jumps to address that is not known statically
+	// (e.g., uses index register) or is outside of the program
+	bool has_unknown_successor{false};
+};
+
+// Blocks reachable from the start address of the program, sorted by address.
+// Jumps are followed statically: `JMP` is treated as subroutine call
+// (execution may continue after it), `JSJ` and `HLT` end the path.
+// Word that is not valid MIX command ends the path too
+struct ControlFlowGraph
+{
+	int entry_address{-1};
+	std::vector<BasicBlock> blocks;
+};
+
+// Throws `DisassembleError` when the program has words outside of memory
+MIXAL_LIB_EXPORT
+ControlFlowGraph BuildControlFlowGraph(const TranslatedProgram& program);
+
+struct DisassembledWord
+{
+	int address{0};
+	Word value;
+	// Reachable from the start address, otherwise it's data
+	bool is_code{false};
+	// Empty when the address is not referenced
+	std::string label;
+	// MIX operation for code, CON or ALF for data
+	OperationId id{OperationId::Unknown};
+	// Address part in MIXAL syntax: "ADDRESS,I(F)", value of CON
+	// or quoted text of ALF
+	std::string operand;
+};
+
+struct DisassembledProgram
+{
+	// Sorted by address, the last word is taken when address is repeated
+	std::vector<DisassembledWord> words;
+	// Label or number for END
+	std::string start_operand;
+	std::size_t code_words_count{0};
+	std::size_t data_words_count{0};
+};
+
+// Debug symbols of MDK code file (name and value)
+using SymbolsNames = std::vector<std::pair<std::string, long>>;
+
+// Reconstructs MIXAL source from translated program. Code is found
+// with `BuildControlFlowGraph()`; jump targets and addresses referenced
+// by memory commands get labels: names from `symbols` (when one has
+// the same value) or synthesized ones ("L" + address for code,
+// "D" + address for data). Translating the result gives the same words
+MIXAL_LIB_EXPORT
+DisassembledProgram Disassemble(const TranslatedProgram& program,
+	const SymbolsNames& symbols = {});
+
+// One line per word, ORIG before each gap in addresses and END
+MIXAL_LIB_EXPORT
+void WriteDisassembledProgram(std::ostream& out, const DisassembledProgram& program);
+
+} // namespace mixal
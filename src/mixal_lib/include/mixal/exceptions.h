@@ -2,6 +2,7 @@
 #include <mixal/types.h>
 
 #include <stdexcept>
+#include <string>
 
 namespace mixal {
 
@@ -33,42 +34,63 @@ public:
 	}
 };
 
-class DuplicateSymbolDefinitionError :
+// Error about the symbol. Name is copied, since symbol
+// refers to the source line
+class SymbolError :
 	public MixalException
 {
 public:
-	DuplicateSymbolDefinitionError(const Symbol& /*symbol*/, const Word& /*value*/)
-		: MixalException{"duplicate symbol definition"}
+	SymbolError(const char* message, const Symbol& symbol)
+		: MixalException{message}
+		, symbol_name_{symbol.name()}
+	{
+	}
+
+	const std::string& symbol_name() const
+	{
+		return symbol_name_;
+	}
+
+private:
+	std::string symbol_name_;
+};
+
+class DuplicateSymbolDefinitionError :
+	public SymbolError
+{
+public:
+	DuplicateSymbolDefinitionError(const Symbol& symbol, const Word& /*value*/)
+		: SymbolError{"duplicate symbol definition", symbol}
 	{
 	}
 };
 
 class InvalidLocalSymbolDefinition :
-	public MixalException
+	public SymbolError
 {
 public:
-	InvalidLocalSymbolDefinition(const Symbol& /*symbol*/)
-		: MixalException{"invalid local symbol definition"}
+	InvalidLocalSymbolDefinition(const Symbol& symbol)
+		: SymbolError{"invalid local symbol definition", symbol}
 	{
 	}
 };
 
 class InvalidLocalSymbolReference :
-	public MixalException
+	public SymbolError
 {
 public:
-	InvalidLocalSymbolReference(const Symbol& /*symbol*/)
-		: MixalException{"invalid local symbol reference"}
+	InvalidLocalSymbolReference(const Symbol& symbol)
+		: SymbolError{"invalid local symbol reference", symbol}
 	{
 	}
 };
 
 class UndefinedSymbolError :
-	public MixalException
+	public SymbolError
 {
 public:
-	UndefinedSymbolError(const Symbol& /*symbol*/)
-		: MixalException{"undefined symbol"}
+	UndefinedSymbolError(const Symbol& symbol)
+		: SymbolError{"undefined symbol", symbol}
 	{
 	}
 };
@@ -133,5 +155,55 @@ public:
 	}
 };
 
+class CorruptedProgramImage :
+	public MixalException
+{
+public:
+	CorruptedProgramImage(const char* reason)
+		: MixalException{"corrupted program image: " + std::string(reason)}
+	{
+	}
+};
+
+class ObjectModuleError :
+	public MixalException
+{
+public:
+	ObjectModuleError(const std::string& reason)
+		: MixalException{"object module: " + reason}
+	{
+	}
+};
+
+class LinkError :
+	public MixalException
+{
+public:
+	LinkError(const std::string& reason)
+		: MixalException{"link error: " + reason}
+	{
+	}
+};
+
+class DisassembleError :
+	public MixalException
+{
+public:
+	DisassembleError(const std::string& reason)
+		: MixalException{"disassemble error: " + reason}
+	{
+	}
+};
+
+class SourceFileOpenError :
+	public MixalException
+{
+public:
+	SourceFileOpenError(const std::string& file_path)
+		: MixalException{"failed to open source file " + file_path}
+	{
+	}
+};
+
 } // namespace mixal
 
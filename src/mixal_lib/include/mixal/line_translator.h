@@ -5,6 +5,8 @@
 #include <mixal_parse/line_parser.h>
 #include <mixal_parse/types/operation_id.h>
 
+#include <functional>
+#include <vector>
 #include <list>
 
 
@@ -37,11 +39,61 @@ struct TranslatedProgram
 	int start_address{-1};
 };
 
+// Result of `TranslateLinesUntilEnd()`
+struct TranslatedSource
+{
+	// Translated lines till END (inclusive), index is line's index in the source
+	std::vector<TranslatedLine> lines;
+	TranslatedProgram program;
+	// Index in `lines` of each word of `program.commands`
+	std::vector<int> words_lines;
+};
+
+// Words of translated lines in order of translation
+// (words of END line are its defined symbols).
+// Words that are not ready are skipped: it's possible only when
+// translation stopped on error (e.g., there is no END).
+// If `words_lines` is given, index in `lines` of each collected word is stored there
+MIXAL_LIB_EXPORT
+TranslatedProgram CollectProgram(const std::vector<TranslatedLine>& lines,
+	std::vector<int>* words_lines = nullptr);
+
+// Translates source line with given index (returns invalid
+// `TranslatedLine` for lines without code)
+using TranslateLineFunction = std::function<TranslatedLine (std::size_t line_index)>;
+
+// Calls `translate_line` for lines [0; lines_count) until END is translated
+// (or until line with END operation that was not translated, see
+// `TranslatedLine::operation_id`), then collects words of translated lines
+MIXAL_LIB_EXPORT
+TranslatedSource TranslateLinesUntilEnd(std::size_t lines_count,
+	const TranslateLineFunction& translate_line);
+
 MIXAL_LIB_EXPORT
 TranslatedLine TranslateLine(
 	Translator& translator,
 	const mixal_parse::LineParser& line);
 
+// Same as `TranslateLine()`, but label is not defined (e.g., when changed
+// line is translated again and its label is already defined)
+MIXAL_LIB_EXPORT
+TranslatedLine TranslateLineWithoutLabel(
+	Translator& translator,
+	const mixal_parse::LineParser& line);
+
+// Returns nothing for empty lines (or lines with only whitespaces).
+// Throws on invalid line. Depends only on `line` itself,
+// hence can be called for different lines concurrently
+MIXAL_LIB_EXPORT
+std::optional<mixal_parse::LineParser> ParseLine(std::string_view line);
+
+// Same as `TranslateLine()`, but also fills `TranslatedLine::operation_id`
+// and accepts result of `ParseLine()`
+MIXAL_LIB_EXPORT
+TranslatedLine TranslateParsedLine(
+	Translator& translator,
+	const std::optional<mixal_parse::LineParser>& line);
+
 class MIXAL_LIB_EXPORT LinesTranslator
 {
 public:
@@ -53,9 +105,12 @@ public:
 	// Note: empty lines (or lines with only whitespaces) are ignored
     TranslatedLine translate(const std::string& line);
 
+	// Same as `translate()`, but `line` is not copied: it should stay
+	// alive while translated results are used (e.g., line of `SourceBuffer`)
+	TranslatedLine translate_in_place(std::string_view line);
+
 private:
 	std::string_view prepare_line(const std::string& line);
-	std::optional<mixal_parse::LineParser> parse_line(const std::string_view& line) const;
 
 private:
 	Translator& translator_;
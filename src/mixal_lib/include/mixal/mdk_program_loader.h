@@ -3,10 +3,36 @@
 
 #include <mix/computer.h>
 
+#include <string_view>
+#include <ostream>
+#include <utility>
+#include <string>
+#include <vector>
+
 #include <cstdio>
 
 namespace mixal {
 
+// Program in format of GNU MIX Development Kit (MDK) code file
+struct MDKProgram
+{
+	TranslatedProgram program;
+	// Source line for each word of `program.commands`
+	// (debug code files only)
+	std::vector<int> lines;
+	// Debug symbols names and values (debug code files only)
+	std::vector<std::pair<std::string, long>> symbols;
+	std::string source_path;
+};
+
+// Decodes whole code file from memory
+MIXAL_LIB_EXPORT
+MDKProgram ParseMDKProgram(std::string_view data);
+
+// Writes debug code file if there are lines or symbols
+MIXAL_LIB_EXPORT
+void WriteMDKProgram(std::ostream& stream, const MDKProgram& mdk_program);
+
 MIXAL_LIB_EXPORT
 TranslatedProgram ParseProgramFromMDKStream(std::istream& stream);
 
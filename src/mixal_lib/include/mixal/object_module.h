@@ -0,0 +1,89 @@
+#pragma once
+#include <mixal/config.h>
+#include <mixal/line_translator.h>
+#include <mixal/source_buffer.h>
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace mixal {
+
+// Part of the word that is adjusted when module is placed to memory
+enum class RelocationKind : std::uint8_t
+{
+	// (0:2) field of MIX command
+	Address = 0,
+	// Whole word (e.g., `CON LABEL`)
+	Word = 1,
+};
+
+struct Relocation
+{
+	static constexpr int k_module_base = -1;
+
+	// Index in `ObjectModule::words`
+	std::size_t word_index{0};
+	RelocationKind kind{RelocationKind::Address};
+	// Index in `ObjectModule::imports` or `k_module_base`
+	// for references to the module's own addresses
+	int import_index{k_module_base};
+};
+
+struct ExportedSymbol
+{
+	std::string name;
+	Word value;
+	// Value is an address inside the module
+	bool relocatable{false};
+};
+
+// Relocatable translated MIXAL source. Addresses of words are offsets
+// from the start of the module. Symbols that are left undefined on END
+// are imported (instead of being placed to memory as zero words);
+// all other usual symbols are exported. Local symbols (`1H`) are never exported
+struct ObjectModule
+{
+	static constexpr std::uint32_t k_version = 2;
+
+	std::vector<TranslatedWord> words;
+	// Location counter after END, so memory reserved at the end
+	// of the module (e.g., `BUF ORIG *+10`) is counted too
+	int size{0};
+	std::vector<Relocation> relocations;
+	std::vector<std::string> imports;
+	std::vector<ExportedSymbol> exports;
+	// Offset of END's address
+	int start_address{0};
+	bool start_relocatable{true};
+};
+
+// Throws `ObjectModuleError` when some word depends on symbols in
+// other way than `address + offset` (e.g., `2*LABEL` or `LABEL/2`) or when
+// the module contains absolute ORIG. EQU needs already defined value,
+// so symbols can't depend on imported ones: `X EQU EXT+1`
+// throws `UndefinedSymbolError`
+MIXAL_LIB_EXPORT
+ObjectModule TranslateModule(const SourceBuffer& source);
+
+MIXAL_LIB_EXPORT
+void WriteObjectModule(std::ostream& out, const ObjectModule& module);
+
+// Throws `ObjectModuleError`
+MIXAL_LIB_EXPORT
+ObjectModule ReadObjectModule(std::istream& in);
+
+// Places modules one after another starting from `base_address`,
+// resolves imports with exports of all modules and applies relocations.
+// Symbol that few modules define with different values stays private
+// to each of them and can't be imported.
+// Start address of the program is start address of the first module.
+// Throws `LinkError`
+MIXAL_LIB_EXPORT
+TranslatedProgram LinkModules(const std::vector<ObjectModule>& modules,
+	int base_address = 0);
+
+} // namespace mixal
@@ -0,0 +1,28 @@
+#pragma once
+#include <mixal/config.h>
+#include <mixal/line_translator.h>
+#include <mixal/source_buffer.h>
+
+#include <cstddef>
+
+namespace mixal {
+
+struct ParallelTranslateOptions
+{
+	// 0 means std::thread::hardware_concurrency()
+	std::size_t threads_count = 0;
+	// Lines parsed by single task. Sources that are not
+	// longer than one chunk are parsed on calling thread
+	std::size_t chunk_lines = 1024;
+	LiteralsPooling literals_pooling = LiteralsPooling::Disabled;
+};
+
+// Two-phase `TranslateProgram()`: all lines are parsed in parallel
+// (parsing does not depend on other lines), then parsed lines are
+// translated in order (addresses and symbols depend on previous lines).
+// Result and thrown errors are the same as for `TranslateProgram()`
+MIXAL_LIB_EXPORT
+TranslatedProgram TranslateProgramParallel(const SourceBuffer& source,
+	const ParallelTranslateOptions& options = {});
+
+} // namespace mixal
@@ -2,10 +2,10 @@
 #include <mix/computer.h>
 #include <mixal/line_translator.h>
 #include <mixal/program_loader.h>
+#include <mixal/source_buffer.h>
 
 #include <istream>
-
-#include <cassert>
+#include <string>
 
 namespace mixal {
 
@@ -21,6 +21,18 @@ inline int ExecuteProgram(const TranslatedProgram& program)
 	return computer.run();
 }
 
+inline TranslatedProgram TranslateProgram(const SourceBuffer& source)
+{
+    Translator translator;
+    LinesTranslator lines_translator{translator};
+    const auto& lines = source.lines();
+    return TranslateLinesUntilEnd(lines.size(), [&](std::size_t index)
+    {
+        return lines_translator.translate_in_place(lines[index]);
+    }).program;
+}
+
+// Reads `in` only till END line (the rest of the stream is left as is)
 inline TranslatedProgram TranslateProgram(std::istream& in)
 {
     Translator translator;
@@ -37,25 +49,7 @@ inline TranslatedProgram TranslateProgram(std::istream& in)
         }
     }
 
-    TranslatedProgram program;
-    program.commands.reserve(lines.size());
-    for (TranslatedLine& line : lines)
-    {
-        if (line.word_ref)
-        {
-            assert(line.word_ref->is_ready());
-            program.commands.push_back(line.word_ref->translated_word());
-        }
-        else if (line.end_code)
-        {
-            program.start_address = line.end_code->start_address;
-            for (const auto& end_symbols : line.end_code->defined_symbols)
-            {
-                program.commands.push_back(end_symbols.second);
-            }
-        }
-    }
-	return program;
+    return CollectProgram(lines);
 }
 
 } // namespace mixal
@@ -0,0 +1,64 @@
+#pragma once
+#include <mixal/config.h>
+#include <mixal/line_translator.h>
+#include <mixal/source_buffer.h>
+
+#include <string_view>
+#include <istream>
+#include <ostream>
+#include <utility>
+#include <string>
+#include <vector>
+
+#include <cstdint>
+
+namespace mixal {
+
+// Already translated program that can be saved to (and loaded from)
+// binary image instead of translating MIXAL source again
+struct ProgramImage
+{
+	// Images of other versions are not loaded. Version of the format only,
+	// cache file name also has `Translator::k_version`
+	static constexpr std::uint32_t k_version = 1;
+
+	// See `HashSource()`
+	std::uint64_t source_hash{0};
+	TranslatedProgram program;
+	// Usual symbols defined by the program
+	std::vector<std::pair<std::string, Word>> symbols;
+	// Source line (starting from 1) for each word of `program.commands`
+	std::vector<int> lines;
+};
+
+// 64-bit FNV-1a of source text
+MIXAL_LIB_EXPORT
+std::uint64_t HashSource(std::string_view text);
+
+// Same as `TranslateProgram()`, but also collects symbols and lines
+MIXAL_LIB_EXPORT
+ProgramImage TranslateProgramImage(const SourceBuffer& source,
+	LiteralsPooling literals_pooling = LiteralsPooling::Disabled);
+
+// Layout (all numbers are little-endian):
+// header (magic, version, source hash, start address, sections sizes),
+// words (address, packed sign and bytes), lines, symbols (length, name, word).
+// Fixed-size sections come first, so they can be read with single `read()`
+MIXAL_LIB_EXPORT
+void WriteProgramImage(std::ostream& out, const ProgramImage& image);
+
+// Throws `CorruptedProgramImage` (also for image of other version)
+MIXAL_LIB_EXPORT
+ProgramImage ReadProgramImage(std::istream& in);
+
+// Looks for image of the same source in `cache_dir` and translates
+// the source only if there is no valid one. Newly translated image
+// is saved to the cache (failure to save is not an error).
+// Images translated with different `literals_pooling` or by other
+// `Translator::k_version` are cached separately
+MIXAL_LIB_EXPORT
+ProgramImage LoadOrTranslateProgramImage(const SourceBuffer& source,
+	const std::string& cache_dir,
+	LiteralsPooling literals_pooling = LiteralsPooling::Disabled);
+
+} // namespace mixal
@@ -0,0 +1,35 @@
+#pragma once
+#include <mixal/config.h>
+
+#include <string_view>
+#include <istream>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace mixal {
+
+// Whole source text that is read once and split to lines in place.
+// Lines are views into single buffer that does not move
+// (even when `SourceBuffer` itself is moved), so parsed symbols
+// and translated words can refer to them without copying every line.
+//
+// Lines are split the same way as `std::getline()` does:
+// '\n' is removed, everything else is kept as is
+class MIXAL_LIB_EXPORT SourceBuffer
+{
+public:
+	explicit SourceBuffer(std::string text);
+
+	static SourceBuffer FromFile(const std::string& file_path);
+	static SourceBuffer FromStream(std::istream& in);
+
+	std::string_view text() const;
+	const std::vector<std::string_view>& lines() const;
+
+private:
+	std::unique_ptr<const std::string> text_;
+	std::vector<std::string_view> lines_;
+};
+
+} // namespace mixal
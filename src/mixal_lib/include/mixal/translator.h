@@ -2,10 +2,14 @@
 #include <mixal/config.h>
 #include <mixal/types.h>
 
+#include <exception>
+#include <functional>
 #include <map>
 #include <vector>
 #include <memory>
 
+#include <cstdint>
+
 namespace mixal {
 
 // #TODO: move to core lib.
@@ -18,6 +22,28 @@ using FlatMap = std::vector<std::pair<K, V>>;
 
 struct OperationInfo;
 
+// How literal constants (`=value=`) are placed to memory on END
+enum class LiteralsPooling
+{
+	// Separate word for every literal constant
+	Disabled,
+	// Single word for all literal constants with the same value
+	SameValues,
+	// Same as `SameValues`, but literal constant also refers to CON word
+	// with the same value (if any). Program should not modify such CON word
+	SameValuesAndCON,
+};
+
+// Error of already translated word that is found only when its forward
+// reference is resolved (or when its literal constant is evaluated on END)
+struct ResolveError
+{
+	// Word that refers to the symbol (or literal). Few words may have
+	// the same address (e.g., after ORIG back), so word itself is given
+	FutureTranslatedWordRef word;
+	std::exception_ptr error;
+};
+
 class MIXAL_LIB_EXPORT Translator
 {
 public:
@@ -31,6 +57,11 @@ public:
 		int start_address = 0;
 	};
 
+	// Should be increased on any change that gives other words or symbols
+	// for the same source (e.g., placement of literal constants):
+	// cached translations (see program_image.h) of other versions are not used
+	static constexpr std::uint32_t k_version = 1;
+
 public:
 	Translator(const DefinedSymbols& symbols = {},
 		const DefinedLocalSymbols& local_symbols = {},
@@ -56,16 +87,33 @@ public:
 	TranslatedWord translate_CON(const WValue& address, const Label& label = {});
 	TranslatedWord translate_ALF(const Text& text, const Label& label = {});
 
+	// Stores already translated word (e.g., result of `translate_CON()`)
+	// together with words of `translate_MIX()`
+	FutureTranslatedWordRef hold_word(const TranslatedWord& word);
+
 	EndCommandGeneratedCode translate_END(const WValue& address, const Label& label = {});
 
 	void set_current_address(int address);
 	int current_address() const;
 
+	// `LiteralsPooling::Disabled` by default
+	void set_literals_pooling(LiteralsPooling pooling);
+
+	// By default errors of forward references resolution are thrown while
+	// the line that defines the symbol (or END) is translated. With `handler`
+	// they are passed to it instead and translation goes on: the word keeps
+	// zero address, literal constant gets zero value
+	using ResolveErrorsHandler = std::function<void (const ResolveError&)>;
+	void set_resolve_errors_handler(ResolveErrorsHandler handler);
+
 	void define_symbol(const Symbol& symbol, const Word& value);
 	Word query_defined_symbol(const Symbol& symbol, int near_address = -1) const;
 
 	bool is_defined_symbol(const Symbol& symbol, int near_address = -1) const;
 
+	// Usual (not local) symbols. Names are valid while `Translator` is alive
+	FlatMap<Symbol, Word> defined_symbols() const;
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl;
@@ -5,7 +5,9 @@
 
 #include <mixal_parse/types/all.h>
 
-#include <memory>
+#include <vector>
+
+#include <cstddef>
 
 namespace mixal {
 
@@ -42,6 +44,11 @@ struct FutureTranslatedWord :
 {
 	std::vector<Symbol> forward_references;
 	Address unresolved_address;
+	// Value of leading tokens of `unresolved_address` expression that
+	// do not depend on forward references (evaluation is left to right),
+	// so resolution only has to evaluate the rest
+	Word folded_address{};
+	std::size_t folded_tokens_count{0};
 
 	FutureTranslatedWord(int address, std::vector<Symbol> references = {})
 		: forward_references{std::move(references)}
@@ -60,9 +67,54 @@ struct FutureTranslatedWord :
 	}
 };
 
-// Note: using `std::shared_ptr` for simplicity purpose. It can be optimized
-// by using simple wrapper around `TranslatedWord` with reference to `Translator`
-using FutureTranslatedWordRef = std::shared_ptr<const FutureTranslatedWord>;
-using FutureTranslatedWordShared = std::shared_ptr<FutureTranslatedWord>;
+// Lightweight handle to the word owned by `Translator`
+// (see `Translator::translate_MIX()`). Valid while `Translator` is alive
+class FutureTranslatedWordRef
+{
+public:
+	FutureTranslatedWordRef() = default;
+
+	FutureTranslatedWordRef(std::nullptr_t)
+	{
+	}
+
+	explicit FutureTranslatedWordRef(const FutureTranslatedWord* word)
+		: word_{word}
+	{
+	}
+
+	const FutureTranslatedWord* get() const
+	{
+		return word_;
+	}
+
+	const FutureTranslatedWord* operator->() const
+	{
+		return word_;
+	}
+
+	const FutureTranslatedWord& operator*() const
+	{
+		return *word_;
+	}
+
+	explicit operator bool() const
+	{
+		return (word_ != nullptr);
+	}
+
+	friend bool operator==(const FutureTranslatedWordRef& lhs, const FutureTranslatedWordRef& rhs)
+	{
+		return (lhs.word_ == rhs.word_);
+	}
+
+	friend bool operator!=(const FutureTranslatedWordRef& lhs, const FutureTranslatedWordRef& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+private:
+	const FutureTranslatedWord* word_{nullptr};
+};
 
 } // namespace mixal
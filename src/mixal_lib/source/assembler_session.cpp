@@ -0,0 +1,295 @@
+#include <mixal/assembler_session.h>
+#include <mixal/program_loader.h>
+#include <mixal/translator.h>
+
+#include <optional>
+
+using namespace mixal;
+using namespace mixal_parse;
+
+namespace {
+
+// What incremental translation needs to know about line
+// to decide if it can be translated again in place
+struct LineLayout
+{
+	std::string label;
+	int address{-1};
+	bool has_literal_constant{false};
+};
+
+LineLayout QueryLineLayout(const std::optional<LineParser>& line)
+{
+	LineLayout layout;
+	if (!line || line->has_only_comment())
+	{
+		return layout;
+	}
+	if (const auto label_parser = line->label_parser())
+	{
+		layout.label = std::string{label_parser->label().name()};
+	}
+	if (const auto address_parser = line->address())
+	{
+		if (const auto mix = address_parser->mix())
+		{
+			layout.has_literal_constant = mix->address_parser.address().has_literal_constant();
+		}
+	}
+	return layout;
+}
+
+OperationId QueryOperationId(const std::optional<LineParser>& line)
+{
+	if (!line || line->has_only_comment())
+	{
+		return OperationId::Unknown;
+	}
+	return line->operation_parser()->operation().id();
+}
+
+bool ChangesLayout(OperationId id)
+{
+	switch (id)
+	{
+	case OperationId::EQU:
+	case OperationId::ORIG:
+	case OperationId::END:
+		return true;
+	default:
+		return false;
+	}
+}
+
+std::size_t WordsCount(OperationId id)
+{
+	// Only END may have more than one word and it's never
+	// translated incrementally
+	return ((id == OperationId::Unknown) || ChangesLayout(id)) ? 0 : 1;
+}
+
+} // namespace
+
+struct AssemblerSession::Impl
+{
+	// Source of the last full assembly. Translator refers to names
+	// of its symbols: changed lines never define new symbols and
+	// are translated again only if all their words are ready
+	SourceBuffer full_source{std::string{}};
+	// Current source when it differs from `full_source`
+	std::optional<SourceBuffer> changed_source;
+	std::unique_ptr<Translator> translator;
+	TranslatedProgram program;
+	std::vector<AssembledLine> lines;
+	std::vector<LineLayout> layouts;
+
+	const SourceBuffer& source() const
+	{
+		return changed_source ? *changed_source : full_source;
+	}
+
+	void reset()
+	{
+		full_source = SourceBuffer{std::string{}};
+		changed_source.reset();
+		translator.reset();
+		program = {};
+		lines.clear();
+		layouts.clear();
+	}
+
+	Result assemble_full(SourceBuffer source);
+	std::optional<Result> try_assemble_changes(SourceBuffer& source);
+};
+
+AssemblerSession::Result AssemblerSession::Impl::assemble_full(SourceBuffer source)
+{
+	reset();
+	full_source = std::move(source);
+	translator = std::make_unique<Translator>();
+
+	const auto& source_lines = full_source.lines();
+	layouts.reserve(source_lines.size());
+	auto translated = TranslateLinesUntilEnd(source_lines.size(), [&](std::size_t index)
+	{
+		const auto parsed = ParseLine(source_lines[index]);
+		layouts.push_back(QueryLineLayout(parsed));
+		return TranslateParsedLine(*translator, parsed);
+	});
+	program = std::move(translated.program);
+
+	// Words of each line follow each other
+	const auto& words_lines = translated.words_lines;
+	std::size_t word = 0;
+	lines.reserve(translated.lines.size());
+	for (std::size_t i = 0; i < translated.lines.size(); ++i)
+	{
+		AssembledLine assembled;
+		assembled.operation_id = translated.lines[i].operation_id;
+		assembled.first_word = word;
+		while ((word < words_lines.size())
+			&& (static_cast<std::size_t>(words_lines[word]) == i))
+		{
+			++word;
+		}
+		assembled.words_count = word - assembled.first_word;
+		if (translated.lines[i].word_ref && (assembled.words_count > 0))
+		{
+			layouts[i].address = program.commands[assembled.first_word].original_address;
+		}
+		lines.push_back(assembled);
+	}
+
+	return Result{};
+}
+
+std::optional<AssemblerSession::Result>
+	AssemblerSession::Impl::try_assemble_changes(SourceBuffer& source)
+{
+	if (!translator)
+	{
+		return std::nullopt;
+	}
+	const auto& old_lines = this->source().lines();
+	const auto& new_lines = source.lines();
+	if (old_lines.size() != new_lines.size())
+	{
+		return std::nullopt;
+	}
+
+	// Lines after END are not translated, changes there do not matter
+	const std::size_t count = lines.size();
+	std::vector<std::size_t> changed;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (old_lines[i] != new_lines[i])
+		{
+			changed.push_back(i);
+		}
+	}
+
+	// Parse everything first, so parse error does not leave
+	// the session with half of changes applied
+	std::vector<std::optional<LineParser>> parsed;
+	parsed.reserve(changed.size());
+	for (std::size_t i : changed)
+	{
+		parsed.push_back(ParseLine(new_lines[i]));
+		const OperationId old_id = lines[i].operation_id;
+		const OperationId new_id = QueryOperationId(parsed.back());
+		if (ChangesLayout(old_id) || ChangesLayout(new_id)
+			|| (WordsCount(old_id) != WordsCount(new_id)))
+		{
+			return std::nullopt;
+		}
+		const LineLayout layout = QueryLineLayout(parsed.back());
+		if (layouts[i].has_literal_constant || layout.has_literal_constant
+			|| (layouts[i].label != layout.label))
+		{
+			return std::nullopt;
+		}
+	}
+
+	// Labels and addresses are the same, hence values of all symbols
+	// are the same and only changed lines have new words
+	std::vector<TranslatedWord> words;
+	words.reserve(changed.size());
+	for (std::size_t k = 0; k < changed.size(); ++k)
+	{
+		const std::size_t i = changed[k];
+		if (lines[i].words_count == 0)
+		{
+			continue;
+		}
+		translator->set_current_address(layouts[i].address);
+		const TranslatedLine line = TranslateLineWithoutLabel(*translator, *parsed[k]);
+		if (!line.word_ref || !line.word_ref->is_ready())
+		{
+			// E.g., reference to undefined symbol that becomes
+			// new word on END
+			return std::nullopt;
+		}
+		words.push_back(line.word_ref->translated_word());
+	}
+
+	Result result;
+	result.full_assembly = false;
+	std::size_t word_k = 0;
+	for (std::size_t k = 0; k < changed.size(); ++k)
+	{
+		AssembledLine& assembled = lines[changed[k]];
+		assembled.operation_id = QueryOperationId(parsed[k]);
+		if (assembled.words_count > 0)
+		{
+			program.commands[assembled.first_word] = words[word_k];
+			result.patched_words.push_back(words[word_k]);
+			++word_k;
+		}
+	}
+	// Only one changed source is kept, previous one is not referenced
+	changed_source = std::move(source);
+	return result;
+}
+
+AssemblerSession::AssemblerSession()
+	: impl{std::make_unique<Impl>()}
+{
+}
+
+AssemblerSession::~AssemblerSession() = default;
+
+AssemblerSession::AssemblerSession(AssemblerSession&&) noexcept = default;
+AssemblerSession& AssemblerSession::operator=(AssemblerSession&&) noexcept = default;
+
+AssemblerSession::Result AssemblerSession::assemble(std::string text)
+{
+	SourceBuffer source{std::move(text)};
+	try
+	{
+		if (auto result = impl->try_assemble_changes(source))
+		{
+			return std::move(*result);
+		}
+		return impl->assemble_full(std::move(source));
+	}
+	catch (...)
+	{
+		impl->reset();
+		throw;
+	}
+}
+
+void AssemblerSession::apply(mix::Computer& computer, const Result& result) const
+{
+	if (result.full_assembly)
+	{
+		LoadProgram(computer, impl->program);
+		return;
+	}
+
+	for (const auto& word : result.patched_words)
+	{
+		computer.set_memory(word.original_address, word.value);
+	}
+	computer.set_next_address(impl->program.start_address);
+}
+
+void AssemblerSession::reset()
+{
+	impl->reset();
+}
+
+const TranslatedProgram& AssemblerSession::program() const
+{
+	return impl->program;
+}
+
+const std::vector<AssemblerSession::AssembledLine>& AssemblerSession::lines() const
+{
+	return impl->lines;
+}
+
+const SourceBuffer& AssemblerSession::source() const
+{
+	return impl->source();
+}
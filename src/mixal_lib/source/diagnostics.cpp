@@ -0,0 +1,284 @@
+#include <mixal/diagnostics.h>
+#include <mixal/exceptions.h>
+
+#include <mixal_parse/label_parser.h>
+#include <mixal_parse/parsers_utils.h>
+
+#include <mix/exceptions.h>
+
+#include <core/string.h>
+
+#include <unordered_map>
+#include <algorithm>
+
+using namespace mixal;
+using namespace mixal_parse;
+
+namespace {
+
+// Column of `name` that is a separate word of `line`
+std::size_t FindSymbolColumn(std::string_view line, std::string_view name)
+{
+	if (name.empty())
+	{
+		return 0;
+	}
+
+	for (auto pos = line.find(name); pos != std::string_view::npos;
+		pos = line.find(name, pos + 1))
+	{
+		const auto end = pos + name.size();
+		if (((pos == 0) || !IsSymbolChar(line[pos - 1])) &&
+			((end == line.size()) || !IsSymbolChar(line[end])))
+		{
+			return (pos + 1);
+		}
+	}
+	return 0;
+}
+
+std::size_t FirstCharColumn(std::string_view line)
+{
+	const auto trimmed = core::LeftTrim(line);
+	return trimmed.empty() ? 0 : (line.size() - trimmed.size() + 1);
+}
+
+std::string_view NextWord(std::string_view line, std::size_t& pos)
+{
+	pos = SkipLeftWhiteSpaces(line, pos);
+	const auto begin = pos;
+	pos = std::min(FindFirstWhiteSpace(line, pos), line.size());
+	return line.substr(begin, pos - begin);
+}
+
+bool GeneratesWord(OperationId id)
+{
+	return IsMIXOperation(id)
+		|| (id == OperationId::CON)
+		|| (id == OperationId::ALF);
+}
+
+// What is known about invalid line to keep layout of the program
+struct LineLayout
+{
+	OperationId id{OperationId::Unknown};
+	Label label;
+};
+
+LineLayout QueryLayout(const LineParser& parser)
+{
+	LineLayout layout;
+	if (const auto op_parser = parser.operation_parser())
+	{
+		layout.id = op_parser->operation().id();
+	}
+	if (const auto label_parser = parser.label_parser())
+	{
+		layout.label = label_parser->label();
+	}
+	return layout;
+}
+
+// Line that failed to parse: operation is the first or the second word,
+// in the second case the first word is label
+LineLayout GuessLayout(std::string_view line)
+{
+	std::size_t pos = 0;
+	const auto first = NextWord(line, pos);
+	const auto second = NextWord(line, pos);
+
+	LineLayout layout;
+	layout.id = OperationIdFromString(first);
+	if (layout.id != OperationId::Unknown)
+	{
+		return layout;
+	}
+
+	layout.id = OperationIdFromString(second);
+	LabelParser label_parser;
+	if ((layout.id != OperationId::Unknown) &&
+		!IsInvalidStreamPosition(label_parser.parse_stream(first)))
+	{
+		layout.label = label_parser.label();
+	}
+	return layout;
+}
+
+// Zero word in place of invalid line, so next lines have the same
+// addresses and the label can be referenced
+FutureTranslatedWordRef HoldPlaceholder(Translator& translator,
+	const LineLayout& layout, int address)
+{
+	if (!layout.label.empty() && !translator.is_defined_symbol(layout.label.symbol()))
+	{
+		try
+		{
+			translator.define_symbol(layout.label.symbol(), Word(address));
+		}
+		catch (const MixalException&)
+		{
+			// E.g., invalid local symbol definition, already reported
+		}
+	}
+
+	auto word = translator.hold_word(TranslatedWord{address, Word{}});
+	translator.set_current_address(address + 1);
+	return word;
+}
+
+// Fills position and message of the error thrown for `line`
+void DescribeError(std::exception_ptr error, std::string_view line, Diagnostic& diagnostic)
+{
+	try
+	{
+		std::rethrow_exception(error);
+	}
+	catch (const SymbolError& e)
+	{
+		diagnostic.symbol = e.symbol_name();
+		diagnostic.column = FindSymbolColumn(line, diagnostic.symbol);
+		diagnostic.message = e.what();
+	}
+	catch (const MixalException& e)
+	{
+		diagnostic.column = FirstCharColumn(line);
+		diagnostic.message = e.what();
+	}
+	catch (const mix::MixException& e)
+	{
+		diagnostic.column = FirstCharColumn(line);
+		diagnostic.message = e.what();
+	}
+}
+
+} // namespace
+
+void Diagnostics::add(Diagnostic diagnostic)
+{
+	diagnostics_.push_back(std::move(diagnostic));
+}
+
+bool Diagnostics::empty() const
+{
+	return diagnostics_.empty();
+}
+
+std::size_t Diagnostics::size() const
+{
+	return diagnostics_.size();
+}
+
+const std::vector<Diagnostic>& Diagnostics::all() const
+{
+	return diagnostics_;
+}
+
+namespace mixal {
+
+std::string ToString(const Diagnostic& diagnostic)
+{
+	std::string str = std::to_string(diagnostic.line) + ":"
+		+ std::to_string(diagnostic.column) + ": error: " + diagnostic.message;
+	if (!diagnostic.symbol.empty())
+	{
+		str += " `" + diagnostic.symbol + "`";
+	}
+	return str;
+}
+
+TranslatedProgram TranslateProgram(const SourceBuffer& source, Diagnostics& diagnostics)
+{
+	const auto& lines = source.lines();
+	std::vector<Diagnostic> found;
+
+	// Errors of forward references and literals are found later
+	// (when symbol is defined or on END), but belong to the line
+	// of the word that refers to them
+	std::unordered_map<const FutureTranslatedWord*, std::size_t> word_to_line;
+	Translator translator;
+	translator.set_resolve_errors_handler([&](const ResolveError& error)
+	{
+		const auto it = word_to_line.find(error.word.get());
+		if (it == word_to_line.end())
+		{
+			return;
+		}
+		Diagnostic diagnostic;
+		diagnostic.line = it->second + 1;
+		DescribeError(error.error, lines[it->second], diagnostic);
+		found.push_back(std::move(diagnostic));
+	});
+
+	LineParser parser;
+	auto translated = TranslateLinesUntilEnd(lines.size(), [&](std::size_t i)
+	{
+		const std::string_view line = lines[i];
+		if (core::Trim(line).empty())
+		{
+			return TranslatedLine();
+		}
+
+		Diagnostic diagnostic;
+		diagnostic.line = i + 1;
+		LineLayout layout;
+		const int address = translator.current_address();
+
+		if (IsInvalidStreamPosition(parser.parse_stream(line)))
+		{
+			diagnostic.column = FirstCharColumn(line);
+			diagnostic.message = "parse error";
+			layout = GuessLayout(line);
+		}
+		else
+		{
+			layout = QueryLayout(parser);
+			try
+			{
+				auto translated_line = TranslateLine(translator, parser);
+				translated_line.operation_id = layout.id;
+				if (translated_line.word_ref)
+				{
+					word_to_line.emplace(translated_line.word_ref.get(), i);
+				}
+				return translated_line;
+			}
+			catch (...)
+			{
+				DescribeError(std::current_exception(), line, diagnostic);
+			}
+		}
+
+		found.push_back(std::move(diagnostic));
+		TranslatedLine failed_line;
+		if (GeneratesWord(layout.id) && (translator.current_address() == address))
+		{
+			failed_line = TranslatedLine{HoldPlaceholder(translator, layout, address)};
+		}
+		// Translation stops on END even if it's invalid
+		failed_line.operation_id = layout.id;
+		return failed_line;
+	});
+
+	const bool has_end = !translated.lines.empty()
+		&& (translated.lines.back().operation_id == OperationId::END);
+	if (!has_end)
+	{
+		Diagnostic diagnostic;
+		diagnostic.line = std::max<std::size_t>(lines.size(), 1);
+		diagnostic.message = "missing END";
+		found.push_back(std::move(diagnostic));
+	}
+
+	std::stable_sort(found.begin(), found.end(),
+		[](const Diagnostic& lhs, const Diagnostic& rhs)
+	{
+		return (lhs.line < rhs.line);
+	});
+	for (auto& diagnostic : found)
+	{
+		diagnostics.add(std::move(diagnostic));
+	}
+	return std::move(translated.program);
+}
+
+} // namespace mixal
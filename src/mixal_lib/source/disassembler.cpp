@@ -0,0 +1,563 @@
+#include <mixal/disassembler.h>
+#include <mixal/operation_info.h>
+#include <mixal/exceptions.h>
+
+#include <mix/command.h>
+#include <mix/computer.h>
+#include <mix/char_table.h>
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+#include <unordered_map>
+
+#include <cctype>
+#include <cassert>
+
+namespace mixal {
+
+namespace {
+
+constexpr int k_memory_size = static_cast<int>(mix::Computer::k_memory_words_count);
+constexpr int k_no_word = -1;
+constexpr std::size_t k_label_width = 10;
+constexpr std::size_t k_operation_width = 4;
+
+// Computer commands (C byte) by the meaning of the address part
+bool IsJumpCommand(std::size_t C)
+{
+	return (C == 34) || (C == 38) || ((C >= 39) && (C <= 47));
+}
+
+bool IsMemoryCommand(std::size_t C)
+{
+	return ((C >= 1) && (C <= 4))
+		|| ((C >= 7) && (C <= 33))
+		|| (C == 36) || (C == 37)
+		|| ((C >= 56) && (C <= 63));
+}
+
+// Commands that take (L:R) field of memory word
+bool HasFieldSpecification(std::size_t C)
+{
+	return ((C >= 1) && (C <= 4))
+		|| ((C >= 8) && (C <= 33))
+		|| ((C >= 56) && (C <= 63));
+}
+
+// Both are single lookup in (command, field) table. Commands where
+// field selects operation (ADD/FADD) are decoded with any other
+// field too, as MIX executes them
+OperationInfo DecodeOperation(const mix::Command& command)
+{
+	auto info = QueryOperationInfo(command);
+	if ((info.id == OperationId::Unknown) && HasFieldSpecification(command.id()))
+	{
+		info = QueryOperationInfo(mix::Command{command.id(), 0, 0, Word::MaxField()});
+	}
+	return info;
+}
+
+// Words of the program by address
+class ProgramMemory
+{
+public:
+	explicit ProgramMemory(const TranslatedProgram& program)
+		: words_()
+		, index_(static_cast<std::size_t>(k_memory_size), k_no_word)
+	{
+		words_.reserve(program.commands.size());
+		for (const auto& word : program.commands)
+		{
+			const int address = word.original_address;
+			if ((address < 0) || (address >= k_memory_size))
+			{
+				throw DisassembleError("word address " + std::to_string(address)
+					+ " is outside of memory");
+			}
+
+			int& index = index_[static_cast<std::size_t>(address)];
+			if (index == k_no_word)
+			{
+				index = static_cast<int>(words_.size());
+				words_.push_back(word);
+			}
+			else
+			{
+				words_[static_cast<std::size_t>(index)] = word;
+			}
+		}
+
+		std::sort(words_.begin(), words_.end(),
+			[](const TranslatedWord& lhs, const TranslatedWord& rhs)
+		{
+			return (lhs.original_address < rhs.original_address);
+		});
+		for (std::size_t i = 0; i < words_.size(); ++i)
+		{
+			index_[static_cast<std::size_t>(words_[i].original_address)] = static_cast<int>(i);
+		}
+	}
+
+	bool has_word(int address) const
+	{
+		return (address >= 0) && (address < k_memory_size)
+			&& (index_[static_cast<std::size_t>(address)] != k_no_word);
+	}
+
+	const Word& word(int address) const
+	{
+		assert(has_word(address));
+		return words_[static_cast<std::size_t>(index_[static_cast<std::size_t>(address)])].value;
+	}
+
+	const std::vector<TranslatedWord>& words() const
+	{
+		return words_;
+	}
+
+private:
+	std::vector<TranslatedWord> words_;
+	// Index in `words_` for each memory address
+	std::vector<int> index_;
+};
+
+// How control leaves the command
+struct CommandFlow
+{
+	bool is_valid{false};
+	bool is_jump{false};
+	bool falls_through{true};
+	// -1 when unknown or there is no jump
+	int target{-1};
+};
+
+CommandFlow QueryCommandFlow(const ProgramMemory& memory, int address)
+{
+	CommandFlow flow;
+	const mix::Command command{memory.word(address)};
+	const auto info = DecodeOperation(command);
+	if (info.id == OperationId::Unknown)
+	{
+		return flow;
+	}
+
+	flow.is_valid = true;
+	flow.falls_through = (info.id != OperationId::JSJ) && (info.id != OperationId::HLT);
+	flow.is_jump = IsJumpCommand(command.id());
+	if (flow.is_jump && (command.address_index() == 0)
+		&& memory.has_word(command.address()))
+	{
+		flow.target = command.address();
+	}
+	return flow;
+}
+
+// Addresses reachable from `entry` and starts of basic blocks
+struct CodeMap
+{
+	std::vector<bool> is_code;
+	std::vector<bool> is_leader;
+};
+
+CodeMap FindCode(const ProgramMemory& memory, int entry)
+{
+	CodeMap code;
+	code.is_code.resize(static_cast<std::size_t>(k_memory_size), false);
+	code.is_leader.resize(static_cast<std::size_t>(k_memory_size), false);
+
+	std::vector<int> pending;
+	if (memory.has_word(entry))
+	{
+		pending.push_back(entry);
+		code.is_leader[static_cast<std::size_t>(entry)] = true;
+	}
+
+	while (!pending.empty())
+	{
+		int address = pending.back();
+		pending.pop_back();
+
+		// Straight line till the command that transfers control
+		while (memory.has_word(address) && !code.is_code[static_cast<std::size_t>(address)])
+		{
+			const auto flow = QueryCommandFlow(memory, address);
+			if (!flow.is_valid)
+			{
+				break;
+			}
+			code.is_code[static_cast<std::size_t>(address)] = true;
+			++address;
+
+			if (!flow.is_jump && flow.falls_through)
+			{
+				continue;
+			}
+			if (flow.target >= 0)
+			{
+				code.is_leader[static_cast<std::size_t>(flow.target)] = true;
+				pending.push_back(flow.target);
+			}
+			if (!flow.falls_through)
+			{
+				break;
+			}
+			if (address < k_memory_size)
+			{
+				code.is_leader[static_cast<std::size_t>(address)] = true;
+			}
+		}
+	}
+	return code;
+}
+
+bool IsCode(const CodeMap& code, int address)
+{
+	return (address >= 0) && (address < k_memory_size)
+		&& code.is_code[static_cast<std::size_t>(address)];
+}
+
+bool IsValidSymbolName(const std::string& name)
+{
+	if (name.empty() || (name.size() > k_label_width))
+	{
+		return false;
+	}
+
+	bool has_letter = false;
+	for (char ch : name)
+	{
+		const auto uch = static_cast<unsigned char>(ch);
+		if (!std::isdigit(uch) && !std::isupper(uch))
+		{
+			return false;
+		}
+		has_letter = has_letter || (std::isupper(uch) != 0);
+	}
+
+	// Local symbols (2H, 3B) and operations (LDA) are not used as labels
+	const bool is_local = (name.size() == 2) && std::isdigit(static_cast<unsigned char>(name[0]));
+	return has_letter && !is_local
+		&& (mixal_parse::OperationIdFromString(name) == OperationId::Unknown);
+}
+
+// "ABCDE" if the word looks like text
+bool TryMakeALFText(const Word& word, std::string& text)
+{
+	if (word.sign() != mix::Sign::Positive)
+	{
+		return false;
+	}
+
+	std::size_t letters_count = 0;
+	text.assign(1, '"');
+	for (const auto& byte : word.bytes())
+	{
+		bool converted = false;
+		const char ch = mix::ByteToChar(byte, &converted);
+		const auto uch = static_cast<unsigned char>(ch);
+		if (!converted || (uch >= 0x80) || (ch == '"'))
+		{
+			return false;
+		}
+		letters_count += (std::isupper(uch) ? 1 : 0);
+		text += ch;
+	}
+	text += '"';
+	// Not a small number that happens to have letter codes
+	return (text[1] != ' ') && (letters_count >= 2);
+}
+
+std::string SignedNumber(mix::Sign sign, std::size_t abs_value)
+{
+	const auto str = std::to_string(abs_value);
+	return (sign == mix::Sign::Negative) ? ("-" + str) : str;
+}
+
+std::string FieldString(std::size_t F, std::size_t C)
+{
+	const std::size_t L = F / 8;
+	const std::size_t R = F % 8;
+	if (HasFieldSpecification(C) && (L <= R) && (R <= 5))
+	{
+		return "(" + std::to_string(L) + ":" + std::to_string(R) + ")";
+	}
+	return "(" + std::to_string(F) + ")";
+}
+
+class LabelsBuilder
+{
+public:
+	LabelsBuilder(const ProgramMemory& memory, const CodeMap& code)
+		: memory_{memory}
+		, code_{code}
+		, labels_()
+		, used_names_()
+	{
+	}
+
+	void reference(int address)
+	{
+		if (memory_.has_word(address))
+		{
+			labels_.emplace(address, std::string{});
+		}
+	}
+
+	void name_from_symbols(const SymbolsNames& symbols)
+	{
+		for (const auto& symbol : symbols)
+		{
+			if ((symbol.second < 0) || (symbol.second >= k_memory_size))
+			{
+				continue;
+			}
+			const auto it = labels_.find(static_cast<int>(symbol.second));
+			if ((it != labels_.end()) && it->second.empty()
+				&& IsValidSymbolName(symbol.first) && used_names_.insert(symbol.first).second)
+			{
+				it->second = symbol.first;
+			}
+		}
+	}
+
+	void name(int address, std::string name)
+	{
+		auto it = labels_.find(address);
+		if ((it == labels_.end()) || !it->second.empty())
+		{
+			return;
+		}
+		while (!used_names_.insert(name).second)
+		{
+			name.insert(name.begin(), 'X');
+		}
+		it->second = std::move(name);
+	}
+
+	void name_all()
+	{
+		for (auto& label : labels_)
+		{
+			if (label.second.empty())
+			{
+				std::string address = std::to_string(label.first);
+				address.insert(address.begin(), 4 - address.size(), '0');
+				name(label.first, (IsCode(code_, label.first) ? "L" : "D") + address);
+			}
+		}
+	}
+
+	const std::string* find(int address) const
+	{
+		const auto it = labels_.find(address);
+		return (it != labels_.end()) ? &it->second : nullptr;
+	}
+
+private:
+	const ProgramMemory& memory_;
+	const CodeMap& code_;
+	std::unordered_map<int, std::string> labels_;
+	std::unordered_set<std::string> used_names_;
+};
+
+void DisassembleCommand(DisassembledWord& word, const LabelsBuilder& labels)
+{
+	const mix::Command command{word.value};
+	const auto info = DecodeOperation(command);
+	const int address = command.address();
+	// -0 address can't be written as command
+	if ((info.id == OperationId::Unknown)
+		|| ((command.sign() == mix::Sign::Negative) && (address == 0)))
+	{
+		word.id = OperationId::CON;
+		word.operand = SignedNumber(word.value.sign(), word.value.abs_value());
+		return;
+	}
+
+	word.id = info.id;
+	const std::size_t C = command.id();
+	const std::size_t I = command.address_index();
+	const std::size_t F = command.field();
+
+	const std::string* label = nullptr;
+	if ((I == 0) && (IsJumpCommand(C) || IsMemoryCommand(C)))
+	{
+		label = labels.find(address);
+	}
+	std::string operand = label ? *label : std::to_string(address);
+	if (I != 0)
+	{
+		operand += "," + std::to_string(I);
+	}
+	if (F != info.default_field.to_byte().cast_to<std::size_t>())
+	{
+		operand += FieldString(F, C);
+	}
+	word.operand = (operand != "0") ? std::move(operand) : std::string{};
+}
+
+void DisassembleData(DisassembledWord& word)
+{
+	if (TryMakeALFText(word.value, word.operand))
+	{
+		word.id = OperationId::ALF;
+		return;
+	}
+	word.id = OperationId::CON;
+	word.operand = SignedNumber(word.value.sign(), word.value.abs_value());
+}
+
+void WriteLine(std::ostream& out, std::string_view label,
+	std::string_view operation, std::string_view operand)
+{
+	std::string line{label};
+	line.resize(k_label_width, ' ');
+	line += ' ';
+	line += operation;
+	if (!operand.empty())
+	{
+		line.resize(k_label_width + 1 + k_operation_width, ' ');
+		line += ' ';
+		line += operand;
+	}
+	line += '\n';
+	out << line;
+}
+
+} // namespace
+
+ControlFlowGraph BuildControlFlowGraph(const TranslatedProgram& program)
+{
+	const ProgramMemory memory{program};
+	const auto code = FindCode(memory, program.start_address);
+
+	ControlFlowGraph graph;
+	graph.entry_address = program.start_address;
+	int address = 0;
+	while (address < k_memory_size)
+	{
+		if (!IsCode(code, address))
+		{
+			++address;
+			continue;
+		}
+
+		BasicBlock block;
+		block.begin_address = address;
+		CommandFlow flow;
+		for (;;)
+		{
+			flow = QueryCommandFlow(memory, address);
+			++address;
+			if (flow.is_jump || !flow.falls_through || !IsCode(code, address)
+				|| code.is_leader[static_cast<std::size_t>(address)])
+			{
+				break;
+			}
+		}
+		block.end_address = address;
+
+		if (flow.is_jump)
+		{
+			if (IsCode(code, flow.target))
+			{
+				block.successors.push_back(flow.target);
+			}
+			else
+			{
+				block.has_unknown_successor = true;
+			}
+		}
+		if (flow.falls_through && IsCode(code, address))
+		{
+			block.successors.push_back(address);
+		}
+		std::sort(block.successors.begin(), block.successors.end());
+		block.successors.erase(std::unique(block.successors.begin(), block.successors.end()),
+			block.successors.end());
+
+		graph.blocks.push_back(std::move(block));
+	}
+	return graph;
+}
+
+DisassembledProgram Disassemble(const TranslatedProgram& program,
+	const SymbolsNames& symbols /*= {}*/)
+{
+	const ProgramMemory memory{program};
+	const auto code = FindCode(memory, program.start_address);
+
+	LabelsBuilder labels{memory, code};
+	labels.reference(program.start_address);
+	for (const auto& word : memory.words())
+	{
+		if (!IsCode(code, word.original_address))
+		{
+			continue;
+		}
+		const mix::Command command{word.value};
+		if ((command.address_index() == 0)
+			&& (IsJumpCommand(command.id()) || IsMemoryCommand(command.id())))
+		{
+			labels.reference(command.address());
+		}
+	}
+	labels.name_from_symbols(symbols);
+	labels.name(program.start_address, "START");
+	labels.name_all();
+
+	DisassembledProgram disassembled;
+	disassembled.words.reserve(memory.words().size());
+	for (const auto& translated : memory.words())
+	{
+		DisassembledWord word;
+		word.address = translated.original_address;
+		word.value = translated.value;
+		word.is_code = IsCode(code, word.address);
+		if (const auto label = labels.find(word.address))
+		{
+			word.label = *label;
+		}
+
+		if (word.is_code)
+		{
+			DisassembleCommand(word, labels);
+			++disassembled.code_words_count;
+		}
+		else
+		{
+			DisassembleData(word);
+			++disassembled.data_words_count;
+		}
+		disassembled.words.push_back(std::move(word));
+	}
+
+	if (const auto label = labels.find(program.start_address))
+	{
+		disassembled.start_operand = *label;
+	}
+	else if (program.start_address >= 0)
+	{
+		disassembled.start_operand = std::to_string(program.start_address);
+	}
+	return disassembled;
+}
+
+void WriteDisassembledProgram(std::ostream& out, const DisassembledProgram& program)
+{
+	int next_address = 0;
+	for (const auto& word : program.words)
+	{
+		if (word.address != next_address)
+		{
+			WriteLine(out, {}, "ORIG", std::to_string(word.address));
+		}
+		WriteLine(out, word.label,
+			mixal_parse::OperationIdToString(word.id), word.operand);
+		next_address = word.address + 1;
+	}
+	WriteLine(out, {}, "END", program.start_operand);
+}
+
+} // namespace mixal
@@ -0,0 +1,156 @@
+#pragma once
+#include <mixal/types.h>
+
+#include <istream>
+#include <sstream>
+#include <string>
+
+#include <cstdint>
+#include <cstddef>
+
+namespace mixal {
+namespace internal {
+
+// Helpers for binary formats of translated programs.
+// All numbers are stored in little-endian byte order
+
+// Word is stored as 32-bit number: sign in the highest bit,
+// then 5 bytes of 6 bits each
+constexpr std::uint32_t k_negative_sign_bit = (std::uint32_t{1} << 31);
+constexpr std::size_t k_word_record_size = 8;	// address + packed word
+
+inline std::uint32_t PackWord(const Word& word)
+{
+	std::uint32_t packed = 0;
+	for (std::size_t i = 1; i <= Word::k_bytes_count; ++i)
+	{
+		packed = (packed << Byte::k_bits_count)
+			| word.byte(i).cast_to<std::uint32_t>();
+	}
+	if (word.sign() == mix::Sign::Negative)
+	{
+		packed |= k_negative_sign_bit;
+	}
+	return packed;
+}
+
+inline Word UnpackWord(std::uint32_t packed)
+{
+	constexpr std::uint32_t k_byte_mask = (1u << Byte::k_bits_count) - 1;
+
+	Word word;
+	if (packed & k_negative_sign_bit)
+	{
+		word.set_sign(mix::Sign::Negative);
+	}
+	for (std::size_t i = Word::k_bytes_count; i >= 1; --i)
+	{
+		word.set_byte(i, Byte{packed & k_byte_mask});
+		packed >>= Byte::k_bits_count;
+	}
+	return word;
+}
+
+class BinaryWriter
+{
+public:
+	explicit BinaryWriter(std::string& buffer)
+		: buffer_{buffer}
+	{
+	}
+
+	void u32(std::uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			buffer_ += static_cast<char>((value >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void u64(std::uint64_t value)
+	{
+		u32(static_cast<std::uint32_t>(value));
+		u32(static_cast<std::uint32_t>(value >> 32));
+	}
+
+	void i32(int value)
+	{
+		u32(static_cast<std::uint32_t>(value));
+	}
+
+	void bytes(const char* data, std::size_t size)
+	{
+		buffer_.append(data, size);
+	}
+
+private:
+	std::string& buffer_;
+};
+
+template<typename Error>
+class BinaryReader
+{
+public:
+	BinaryReader(const char* data, std::size_t size)
+		: data_{data}
+		, size_{size}
+		, position_{0}
+	{
+	}
+
+	std::uint32_t u32()
+	{
+		const char* data = take(4);
+		std::uint32_t value = 0;
+		for (int i = 3; i >= 0; --i)
+		{
+			value = (value << 8) | static_cast<unsigned char>(data[i]);
+		}
+		return value;
+	}
+
+	std::uint64_t u64()
+	{
+		const std::uint64_t low = u32();
+		const std::uint64_t high = u32();
+		return (low | (high << 32));
+	}
+
+	int i32()
+	{
+		return static_cast<int>(u32());
+	}
+
+	// Counts read from data should be checked against this
+	// before anything is allocated for them
+	std::size_t remaining() const
+	{
+		return (size_ - position_);
+	}
+
+	const char* take(std::size_t size)
+	{
+		if ((size_ - position_) < size)
+		{
+			throw Error{"unexpected end of data"};
+		}
+		const char* data = data_ + position_;
+		position_ += size;
+		return data;
+	}
+
+private:
+	const char* data_;
+	std::size_t size_;
+	std::size_t position_;
+};
+
+inline std::string ReadAll(std::istream& in)
+{
+	std::ostringstream buffer;
+	buffer << in.rdbuf();
+	return buffer.str();
+}
+
+} // namespace internal
+} // namespace mixal
@@ -0,0 +1,175 @@
+#pragma once
+#include <mixal/types.h>
+
+#include <core/optional.h>
+#include <core/string.h>
+
+#include <unordered_map>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <string>
+#include <array>
+
+#include <cstddef>
+#include <cassert>
+
+namespace mixal {
+namespace internal {
+
+using SymbolId = std::size_t;
+
+// Assigns dense ids (0, 1, 2, ...) to symbol names.
+// Names are copied, so ids do not depend on lifetime of source text
+class SymbolsInterner
+{
+public:
+	static constexpr SymbolId k_invalid_id = static_cast<SymbolId>(-1);
+
+	SymbolId intern(std::string_view name)
+	{
+		const auto it = ids_.find(name);
+		if (it != ids_.end())
+		{
+			return it->second;
+		}
+
+		// `std::deque` does not move existing elements on push_back(),
+		// so views to stored names stay valid
+		names_.emplace_back(name);
+		const SymbolId id = ids_.size();
+		ids_.emplace(names_.back(), id);
+		return id;
+	}
+
+	SymbolId find(std::string_view name) const
+	{
+		const auto it = ids_.find(name);
+		return (it != ids_.end()) ? it->second : k_invalid_id;
+	}
+
+	std::size_t size() const
+	{
+		return ids_.size();
+	}
+
+	std::string_view name(SymbolId id) const
+	{
+		assert(id < names_.size());
+		return names_[id];
+	}
+
+	void clear()
+	{
+		ids_.clear();
+		names_.clear();
+	}
+
+private:
+	std::deque<std::string> names_;
+	std::unordered_map<std::string_view, SymbolId> ids_;
+};
+
+// Values of usual (global) symbols, indexed by interned id
+class UsualSymbolsTable
+{
+public:
+	// Returns false if symbol is already defined
+	bool define(const Symbol& symbol, const Word& value)
+	{
+		const SymbolId id = interner_.intern(symbol.name());
+		if (id >= values_.size())
+		{
+			values_.resize(id + 1);
+		}
+		if (values_[id])
+		{
+			return false;
+		}
+		values_[id] = value;
+		return true;
+	}
+
+	const Word* find(const Symbol& symbol) const
+	{
+		const SymbolId id = interner_.find(symbol.name());
+		if ((id == SymbolsInterner::k_invalid_id) || (id >= values_.size()) || !values_[id])
+		{
+			return nullptr;
+		}
+		return &*values_[id];
+	}
+
+	SymbolsInterner& interner()
+	{
+		return interner_;
+	}
+
+	// Calls `f(name, value)` for all defined symbols in order of interning
+	template<typename F>
+	void for_each(F&& f) const
+	{
+		for (SymbolId id = 0; id < values_.size(); ++id)
+		{
+			if (values_[id])
+			{
+				f(interner_.name(id), *values_[id]);
+			}
+		}
+	}
+
+private:
+	SymbolsInterner interner_;
+	std::vector<std::optional<Word>> values_;
+};
+
+// Addresses of `nH` local symbols: sorted array per digit,
+// so nearest `nB`/`nF` is found with binary search
+class LocalSymbolsTable
+{
+public:
+	static constexpr std::size_t k_ids_count = 10;
+
+	void define(LocalSymbolId id, int address)
+	{
+		auto& addresses = addresses_for(id);
+		addresses.insert(
+			std::upper_bound(addresses.begin(), addresses.end(), address),
+			address);
+	}
+
+	// Nearest address that is less or equal to `near_address`
+	const int* find_backward(LocalSymbolId id, int near_address) const
+	{
+		const auto& addresses = addresses_for(id);
+		auto it = std::upper_bound(addresses.cbegin(), addresses.cend(), near_address);
+		return (it != addresses.cbegin()) ? &*(it - 1) : nullptr;
+	}
+
+	// Nearest address that is greater or equal to `near_address`
+	const int* find_forward(LocalSymbolId id, int near_address) const
+	{
+		const auto& addresses = addresses_for(id);
+		auto it = std::lower_bound(addresses.cbegin(), addresses.cend(), near_address);
+		return (it != addresses.cend()) ? &*it : nullptr;
+	}
+
+private:
+	std::vector<int>& addresses_for(LocalSymbolId id)
+	{
+		assert((id >= 0) && (static_cast<std::size_t>(id) < k_ids_count));
+		return addresses_[static_cast<std::size_t>(id)];
+	}
+
+	const std::vector<int>& addresses_for(LocalSymbolId id) const
+	{
+		assert((id >= 0) && (static_cast<std::size_t>(id) < k_ids_count));
+		return addresses_[static_cast<std::size_t>(id)];
+	}
+
+private:
+	std::array<std::vector<int>, k_ids_count> addresses_;
+};
+
+} // namespace internal
+} // namespace mixal
@@ -0,0 +1,45 @@
+#pragma once
+#include <mixal/types.h>
+
+#include <vector>
+#include <utility>
+
+#include <cstddef>
+
+namespace mixal {
+namespace internal {
+
+// Owns all words translated by `Translator` for the whole program.
+// Words are allocated in fixed-size blocks and never move,
+// so pointers to them (`FutureTranslatedWordRef`) stay valid
+class WordsArena
+{
+public:
+	static constexpr std::size_t k_block_size = 256;
+
+	template<typename... Args>
+	FutureTranslatedWord& emplace(Args&&... args)
+	{
+		if (blocks_.empty() || (blocks_.back().size() == k_block_size))
+		{
+			blocks_.emplace_back();
+			// Capacity is never exceeded, hence no reallocation
+			blocks_.back().reserve(k_block_size);
+		}
+		auto& block = blocks_.back();
+		block.emplace_back(std::forward<Args>(args)...);
+		return block.back();
+	}
+
+	std::size_t size() const
+	{
+		return blocks_.empty() ? 0
+			: ((blocks_.size() - 1) * k_block_size + blocks_.back().size());
+	}
+
+private:
+	std::vector<std::vector<FutureTranslatedWord>> blocks_;
+};
+
+} // namespace internal
+} // namespace mixal
@@ -11,12 +11,9 @@ namespace {
 // Using this kind of conversion to unify interface of native Translator class
 // (that returns `FutureTranslatedWordRef` or simply `TranslatedWord` depending
 // on called `translate*()` function)
-FutureTranslatedWordRef MakeFutureWord(const TranslatedWord& word)
+FutureTranslatedWordRef MakeFutureWord(Translator& translator, const TranslatedWord& word)
 {
-	auto ref = std::make_shared<FutureTranslatedWord>(word.original_address);
-	ref->value = word.value;
-	// Help Clang: -Wreturn-std-move-in-c++11 
-	return std::move(ref);
+	return translator.hold_word(word);
 }
 
 FutureTranslatedWordRef MakeNullFutureWord()
@@ -84,9 +81,12 @@ TranslatedLine::TranslatedLine(EndCommandGeneratedCode&& end_code_)
     end_code = std::move(end_code_);
 }
 
-TranslatedLine TranslateLine(
+namespace {
+
+TranslatedLine TranslateLineWithLabel(
 	Translator& translator,
-	const LineParser& line)
+	const LineParser& line,
+	const Label& label)
 {
 	if (line.has_only_comment())
 	{
@@ -94,7 +94,6 @@ TranslatedLine TranslateLine(
 	}
 
 	const auto operation = QueryOperation(line);
-	const auto label = QueryLabel(line);
 	const auto address = QueryAddress(line);
 
 	switch (operation.id())
@@ -108,10 +107,10 @@ TranslatedLine TranslateLine(
 			QueryWValue(address), label);
 		return MakeNullFutureWord();
 	case OperationId::CON:
-		return MakeFutureWord(translator.translate_CON(
+		return MakeFutureWord(translator, translator.translate_CON(
 			QueryWValue(address), label));
 	case OperationId::ALF:
-		return MakeFutureWord(translator.translate_ALF(
+		return MakeFutureWord(translator, translator.translate_ALF(
 			QueryALFText(address), label));
 	case OperationId::END:
 		return translator.translate_END(
@@ -129,37 +128,23 @@ TranslatedLine TranslateLine(
 	}
 }
 
-} // namespace mixal
-
-LinesTranslator::LinesTranslator(Translator& translator)
-	: translator_{translator}
-    , cached_lines_{}
-{
-}
+} // namespace
 
-TranslatedLine LinesTranslator::translate(const std::string& line)
+TranslatedLine TranslateLine(
+	Translator& translator,
+	const LineParser& line)
 {
-	auto parser = parse_line(prepare_line(line));
-    if (!parser)
-    {
-        return TranslatedLine();
-    }
-    auto translated = TranslateLine(translator_, *parser);
-    if (const auto op_parser = parser->operation_parser())
-    {
-        translated.operation_id = op_parser->operation().id();
-    }
-    return translated;
+	return TranslateLineWithLabel(translator, line, QueryLabel(line));
 }
 
-std::string_view LinesTranslator::prepare_line(const std::string& line)
+TranslatedLine TranslateLineWithoutLabel(
+	Translator& translator,
+	const LineParser& line)
 {
-	// See `Interpreter::prepare_line()` note
-	cached_lines_.push_back(line);
-	return cached_lines_.back();
+	return TranslateLineWithLabel(translator, line, Label{});
 }
 
-std::optional<LineParser> LinesTranslator::parse_line(const std::string_view& line) const
+std::optional<LineParser> ParseLine(std::string_view line)
 {
 	if (core::Trim(line).empty())
 	{
@@ -176,3 +161,100 @@ std::optional<LineParser> LinesTranslator::parse_line(const std::string_view& li
 	// Help Clang: -Wreturn-std-move-in-c++11 
 	return std::move(parser);
 }
+
+TranslatedLine TranslateParsedLine(
+	Translator& translator,
+	const std::optional<LineParser>& parser)
+{
+	if (!parser)
+	{
+		return TranslatedLine();
+	}
+	auto translated = TranslateLine(translator, *parser);
+	if (const auto op_parser = parser->operation_parser())
+	{
+		translated.operation_id = op_parser->operation().id();
+	}
+	return translated;
+}
+
+TranslatedProgram CollectProgram(const std::vector<TranslatedLine>& lines,
+	std::vector<int>* words_lines /*= nullptr*/)
+{
+	TranslatedProgram program;
+	program.commands.reserve(lines.size());
+	for (std::size_t i = 0; i < lines.size(); ++i)
+	{
+		const TranslatedLine& line = lines[i];
+		if (line.word_ref)
+		{
+			if (!line.word_ref->is_ready())
+			{
+				continue;
+			}
+			program.commands.push_back(line.word_ref->translated_word());
+			if (words_lines)
+			{
+				words_lines->push_back(static_cast<int>(i));
+			}
+		}
+		else if (line.end_code)
+		{
+			program.start_address = line.end_code->start_address;
+			for (const auto& end_symbols : line.end_code->defined_symbols)
+			{
+				program.commands.push_back(end_symbols.second);
+				if (words_lines)
+				{
+					words_lines->push_back(static_cast<int>(i));
+				}
+			}
+		}
+	}
+	return program;
+}
+
+TranslatedSource TranslateLinesUntilEnd(std::size_t lines_count,
+	const TranslateLineFunction& translate_line)
+{
+	TranslatedSource source;
+	source.lines.reserve(lines_count);
+	for (std::size_t i = 0; i < lines_count; ++i)
+	{
+		source.lines.push_back(translate_line(i));
+		const TranslatedLine& line = source.lines.back();
+		if (line.end_code || (line.operation_id == OperationId::END))
+		{
+			break;
+		}
+	}
+
+	source.words_lines.reserve(source.lines.size());
+	source.program = CollectProgram(source.lines, &source.words_lines);
+	return source;
+}
+
+} // namespace mixal
+
+LinesTranslator::LinesTranslator(Translator& translator)
+	: translator_{translator}
+    , cached_lines_{}
+{
+}
+
+TranslatedLine LinesTranslator::translate(const std::string& line)
+{
+	return translate_in_place(prepare_line(line));
+}
+
+TranslatedLine LinesTranslator::translate_in_place(std::string_view line)
+{
+	return TranslateParsedLine(translator_, ParseLine(line));
+}
+
+std::string_view LinesTranslator::prepare_line(const std::string& line)
+{
+	// See `Interpreter::prepare_line()` note
+	cached_lines_.push_back(line);
+	return cached_lines_.back();
+}
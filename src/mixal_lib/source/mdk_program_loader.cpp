@@ -4,7 +4,14 @@
 
 #include <core/optional.h>
 
+#include "internal/binary_io.hpp"
+
 #include <fstream>
+#include <charconv>
+#include <cstring>
+#include <cctype>
+#include <cstdio>
+#include <cassert>
 
 namespace mixal {
 
@@ -28,6 +35,9 @@ using mix_short_t = std::uint16_t;
 
 const std::int32_t k_signature = 0xDEADBEEF;
 const std::int32_t k_signature_debug = 0xBEEFDEAD;
+// Version of MDK's code file format
+const std::int32_t k_version_major = 1;
+const std::int32_t k_version_minor = 0;
 const mix_word_t k_mdk_word_sign_bit = (1L << 30);
 const mix_word_t k_mdk_addr_tag = (k_mdk_word_sign_bit << 1);
 const mix_word_t k_mdk_word_zero = 0;
@@ -75,51 +85,111 @@ bool IsValidSignature(std::int32_t signature)
 	return IsDebugSignature(signature) || IsReleaseSignature(signature);
 }
 
-std::optional<TranslatedWord> ParseNextWord(std::istream& stream
-	, bool is_debug, int& address_counter)
+mix_word_t PackInstruction(const Word& word)
 {
-	mix_word_t next = 0;
-	while (true)
+	mix_word_t tagged = static_cast<mix_word_t>(word.abs_value());
+	if (word.sign() == mix::Sign::Negative)
 	{
-		if (!stream.read(reinterpret_cast<char*>(&next), sizeof(next)))
+		tagged |= k_mdk_word_sign_bit;
+	}
+	return tagged;
+}
+
+mix_word_t PackAddress(int address)
+{
+	return (k_mdk_addr_tag | (static_cast<mix_word_t>(address) & k_mdk_short_max));
+}
+
+// Sequential reads from whole MDK image in memory.
+// Values are stored in native byte order (as MDK does)
+class MDKReader
+{
+public:
+	explicit MDKReader(std::string_view data)
+		: data_{data}
+		, position_{0}
+	{
+	}
+
+	template<typename T>
+	bool read(T& value)
+	{
+		if ((data_.size() - position_) < sizeof(T))
 		{
-			return std::nullopt;
+			return false;
 		}
+		std::memcpy(&value, data_.data() + position_, sizeof(T));
+		position_ += sizeof(T);
+		return true;
+	}
 
-		if (IsAddressWord(next))
+	bool read(std::size_t size, std::string_view& value)
+	{
+		if ((data_.size() - position_) < size)
 		{
-			address_counter = ExtractAddress(next);
+			return false;
 		}
-		else if (IsInstructionWord(next))
+		value = data_.substr(position_, size);
+		position_ += size;
+		return true;
+	}
+
+	int get()
+	{
+		if (position_ >= data_.size())
 		{
-			if (is_debug)
-			{
-				mix_short_t line_number = 0;
-				if (!stream.read(reinterpret_cast<char*>(&line_number), sizeof(line_number)))
-				{
-					return std::nullopt;
-				}
-				(void)line_number;
-			}
+			return EOF;
+		}
+		return static_cast<unsigned char>(data_[position_++]);
+	}
 
-			TranslatedWord translated;
-			translated.original_address = address_counter++;
-			translated.value = ExtractInstruction(next);
-			return translated;
+	// ",name=value" entries, terminated with any other character
+	std::pair<std::string, long> read_symbol()
+	{
+		const auto name_end = data_.find('=', position_);
+		if (name_end == std::string_view::npos)
+		{
+			throw CorruptedMDKStream("failed to read debug symbol");
 		}
+		std::string name{data_.substr(position_, name_end - position_)};
+
+		position_ = name_end + 1;
+		while ((position_ < data_.size()) && std::isspace(static_cast<unsigned char>(data_[position_])))
+		{
+			++position_;
+		}
+
+		long value = 0;
+		const char* begin = data_.data() + position_;
+		const auto result = std::from_chars(begin, data_.data() + data_.size(), value);
+		if (result.ec != std::errc{})
+		{
+			throw CorruptedMDKStream("failed to read debug symbol value");
+		}
+		position_ += static_cast<std::size_t>(result.ptr - begin);
+		return std::make_pair(std::move(name), value);
 	}
 
-	assert(false && "Not reachable");
-	return std::nullopt;
+private:
+	std::string_view data_;
+	std::size_t position_;
+};
+
+template<typename T>
+void WriteRaw(std::string& buffer, const T& value)
+{
+	const char* data = reinterpret_cast<const char*>(&value);
+	buffer.append(data, sizeof(value));
 }
 
 } // namespace
 
-TranslatedProgram ParseProgramFromMDKStream(std::istream& stream)
+MDKProgram ParseMDKProgram(std::string_view data)
 {
+	MDKReader reader{data};
 	// 1. Header
 	mix_cfheader_t header{};
-	if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)))
+	if (!reader.read(header))
 	{
 		throw CorruptedMDKStream("failed to read header");
 	}
@@ -127,41 +197,113 @@ TranslatedProgram ParseProgramFromMDKStream(std::istream& stream)
 	{
 		throw CorruptedMDKStream("invalid signature");
 	}
+
+	MDKProgram mdk_program;
 	// 2. Translated file path
-	std::string file_path(static_cast<std::size_t>(header.path_len) + 1, '\0');
-	if (!stream.read(&(file_path[0]), header.path_len))
+	std::string_view file_path;
+	if (!reader.read(static_cast<std::size_t>(header.path_len), file_path))
 	{
 		throw CorruptedMDKStream("failed to read file path");
 	}
-	(void)file_path;
+	mdk_program.source_path = std::string{file_path.substr(0, file_path.find('\0'))};
 
 	const bool is_debug = IsDebugSignature(header.signature);
 	// 3. Debug symbol names and values
 	if (is_debug)
 	{
-		while (stream.get() == ',')
+		while (reader.get() == ',')
 		{
-			std::string symbol;
-			long value = 0;
-			std::getline(stream, symbol, '=');
-			stream >> value;
-			(void)symbol;
-			(void)value;
+			mdk_program.symbols.push_back(reader.read_symbol());
 		}
 	}
 
-	// 5. Finally, bytecode
-	TranslatedProgram mdk_program;
+	// 5. Finally, bytecode: instructions (followed by line numbers
+	// for debug version) and addresses of following instructions
+	auto& commands = mdk_program.program.commands;
 	int address = 0;
-	while (auto translated = ParseNextWord(stream, is_debug, address))
+	mix_word_t next = 0;
+	while (reader.read(next))
 	{
-		mdk_program.commands.push_back(std::move(*translated));
+		if (IsAddressWord(next))
+		{
+			address = ExtractAddress(next);
+		}
+		else if (IsInstructionWord(next))
+		{
+			if (is_debug)
+			{
+				mix_short_t line_number = 0;
+				if (!reader.read(line_number))
+				{
+					break;
+				}
+				mdk_program.lines.push_back(int{line_number});
+			}
+
+			TranslatedWord translated;
+			translated.original_address = address++;
+			translated.value = ExtractInstruction(next);
+			commands.push_back(std::move(translated));
+		}
 	}
 
-	mdk_program.start_address = header.start;
+	mdk_program.program.start_address = header.start;
 	return mdk_program;
 }
 
+void WriteMDKProgram(std::ostream& stream, const MDKProgram& mdk_program)
+{
+	const auto& commands = mdk_program.program.commands;
+	const bool is_debug = !mdk_program.lines.empty() || !mdk_program.symbols.empty();
+	assert(mdk_program.lines.empty() || (mdk_program.lines.size() == commands.size()));
+
+	std::string buffer;
+	buffer.reserve(sizeof(mix_cfheader_t) + mdk_program.source_path.size()
+		+ commands.size() * (sizeof(mix_word_t) + sizeof(mix_short_t)));
+
+	mix_cfheader_t header{};
+	header.signature = is_debug ? k_signature_debug : k_signature;
+	header.mj_ver = k_version_major;
+	header.mn_ver = k_version_minor;
+	header.start = static_cast<std::int16_t>(mdk_program.program.start_address);
+	header.path_len = mdk_program.source_path.size();
+	WriteRaw(buffer, header);
+	buffer += mdk_program.source_path;
+
+	if (is_debug)
+	{
+		for (const auto& symbol : mdk_program.symbols)
+		{
+			buffer += ',' + symbol.first + '=' + std::to_string(symbol.second);
+		}
+		buffer += '\n';
+	}
+
+	int next_address = -1;
+	for (std::size_t i = 0; i < commands.size(); ++i)
+	{
+		const auto& word = commands[i];
+		if (word.original_address != next_address)
+		{
+			WriteRaw(buffer, PackAddress(word.original_address));
+		}
+		WriteRaw(buffer, PackInstruction(word.value));
+		if (is_debug)
+		{
+			const int line = mdk_program.lines.empty() ? 0 : mdk_program.lines[i];
+			WriteRaw(buffer, static_cast<mix_short_t>(line));
+		}
+		next_address = word.original_address + 1;
+	}
+
+	stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+TranslatedProgram ParseProgramFromMDKStream(std::istream& stream)
+{
+	return ParseMDKProgram(internal::ReadAll(stream)).program;
+}
+
 TranslatedProgram ParseProgramFromMDKFile(const std::string& file_path)
 {
 	std::ifstream input(file_path, std::ios_base::binary);
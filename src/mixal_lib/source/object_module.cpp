@@ -0,0 +1,506 @@
+#include <mixal/object_module.h>
+#include <mixal/exceptions.h>
+#include <mixal/line_translator.h>
+
+#include <mix/computer.h>
+
+#include <core/optional.h>
+
+#include "internal/binary_io.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <array>
+
+#include <cassert>
+
+using namespace mixal;
+using namespace mixal::internal;
+
+namespace {
+
+const std::array<char, 8> k_magic{{'M', 'I', 'X', 'M', 'O', 'D', 'U', 'L'}};
+
+const WordField k_address_field{0, 2};
+
+// Result of translation of the module's source with
+// given values of imported symbols and given start address
+struct ModulePass
+{
+	std::vector<TranslatedWord> words;
+	FlatMap<std::string, Word> symbols;
+	int start_address{0};
+	// Location counter after END (relative to base address)
+	int end_address{0};
+};
+
+TranslatedSource TranslateSource(Translator& translator, const SourceBuffer& source)
+{
+	const auto& lines = source.lines();
+	return TranslateLinesUntilEnd(lines.size(), [&](std::size_t index)
+	{
+		return TranslateParsedLine(translator, ParseLine(lines[index]));
+	});
+}
+
+// Imported symbol with `imported_index` (if any) has `imported_value`,
+// all other imports are 0
+ModulePass TranslatePass(const SourceBuffer& source,
+	const std::vector<std::string>& imports, int imported_index, int imported_value,
+	int base_address)
+{
+	Translator::DefinedSymbols imported_symbols;
+	for (std::size_t i = 0; i < imports.size(); ++i)
+	{
+		const int value = (static_cast<int>(i) == imported_index) ? imported_value : 0;
+		imported_symbols.emplace(Symbol{imports[i]}, Word(value));
+	}
+
+	Translator translator{imported_symbols, {}, base_address};
+	auto program = TranslateSource(translator, source).program;
+
+	ModulePass pass;
+	pass.words = std::move(program.commands);
+	pass.start_address = program.start_address;
+	pass.end_address = translator.current_address() - base_address;
+
+	for (const auto& symbol_value : translator.defined_symbols())
+	{
+		pass.symbols.push_back(std::make_pair(
+			std::string{symbol_value.first.name()}, symbol_value.second));
+	}
+	return pass;
+}
+
+bool IsInternalConstant(const std::string& name)
+{
+	return !name.empty() && (name.front() == '@');
+}
+
+// Symbols that are not defined till END become imports.
+// Usual translation defines them on END (as zero words)
+std::vector<std::string> CollectImports(const SourceBuffer& source)
+{
+	std::vector<std::string> imports;
+	Translator translator;
+	const auto translated = TranslateSource(translator, source);
+	if (translated.lines.empty() || !translated.lines.back().end_code)
+	{
+		return imports;
+	}
+
+	for (const auto& symbol_word : translated.lines.back().end_code->defined_symbols)
+	{
+		std::string name{symbol_word.first.name()};
+		if (!IsInternalConstant(name)
+			&& (std::find(imports.cbegin(), imports.cend(), name) == imports.cend()))
+		{
+			imports.push_back(std::move(name));
+		}
+	}
+	return imports;
+}
+
+bool SameWords(const Word& lhs, const Word& rhs)
+{
+	return (lhs == rhs) && (lhs.sign() == rhs.sign());
+}
+
+bool IsShifted(const Word& original, const Word& changed, RelocationKind kind, int delta)
+{
+	switch (kind)
+	{
+	case RelocationKind::Address:
+		return std::equal(
+				original.bytes().cbegin() + 2, original.bytes().cend(),
+				changed.bytes().cbegin() + 2)
+			&& ((original.value(k_address_field, true).value() + delta)
+				== changed.value(k_address_field, true).value());
+	case RelocationKind::Word:
+		return ((original.value().value() + delta) == changed.value().value());
+	}
+	return false;
+}
+
+// Same module translated with one of the symbols (or module's base
+// address) increased by 1 and by 2
+struct ShiftedPasses
+{
+	ModulePass once;
+	ModulePass twice;
+};
+
+// How word depends on the shifted symbol: it should be the same in all
+// passes (nothing is returned) or be shifted by exactly the same delta.
+// Two deltas tell `address + offset` from, e.g., `address / 2`
+// that is changed by the first shift only for odd addresses
+std::optional<RelocationKind> DetectRelocation(const Word& original,
+	const Word& once, const Word& twice, std::size_t word_index)
+{
+	if (SameWords(original, once) && SameWords(original, twice))
+	{
+		return std::nullopt;
+	}
+
+	for (auto kind : {RelocationKind::Address, RelocationKind::Word})
+	{
+		if (IsShifted(original, once, kind, 1) && IsShifted(original, twice, kind, 2))
+		{
+			return kind;
+		}
+	}
+
+	throw ObjectModuleError{"word #" + std::to_string(word_index)
+		+ " can not be relocated"};
+}
+
+void AddRelocations(const ModulePass& original, const ShiftedPasses& shifted,
+	int import_index, std::vector<Relocation>& relocations)
+{
+	for (std::size_t i = 0; i < original.words.size(); ++i)
+	{
+		if (const auto kind = DetectRelocation(original.words[i].value,
+			shifted.once.words[i].value, shifted.twice.words[i].value, i))
+		{
+			Relocation relocation;
+			relocation.word_index = i;
+			relocation.kind = *kind;
+			relocation.import_index = import_index;
+			relocations.push_back(relocation);
+		}
+	}
+}
+
+void CheckSameLayout(const ModulePass& original, const ModulePass& changed, int shift)
+{
+	if (original.words.size() != changed.words.size())
+	{
+		throw ObjectModuleError{"layout depends on imported symbols"};
+	}
+	for (std::size_t i = 0; i < original.words.size(); ++i)
+	{
+		if ((original.words[i].original_address + shift) != changed.words[i].original_address)
+		{
+			throw ObjectModuleError{"absolute ORIG is not supported"};
+		}
+	}
+}
+
+int RelocatedValue(int value, int delta, int max_abs_value, const char* what)
+{
+	const int relocated = value + delta;
+	if ((relocated > max_abs_value) || (relocated < -max_abs_value))
+	{
+		throw LinkError{std::string{"relocated "} + what + " is too big"};
+	}
+	return relocated;
+}
+
+void Relocate(Word& word, RelocationKind kind, int delta)
+{
+	switch (kind)
+	{
+	case RelocationKind::Address:
+	{
+		const int max_address = (1 << (2 * Byte::k_bits_count)) - 1;
+		const int address = word.value(k_address_field, true).value();
+		word.set_value(WordValue{RelocatedValue(address, delta, max_address, "address")},
+			k_address_field);
+		break;
+	}
+	case RelocationKind::Word:
+		word = Word(RelocatedValue(word.value().value(), delta,
+			static_cast<int>(Word::k_max_abs_value), "word"));
+		break;
+	}
+}
+
+} // namespace
+
+namespace mixal {
+
+ObjectModule TranslateModule(const SourceBuffer& source)
+{
+	ObjectModule module;
+	module.imports = CollectImports(source);
+
+	// Module is translated few times, so the way each word depends
+	// on module's base address and on every imported symbol is
+	// visible from the difference with the original translation
+	const auto original = TranslatePass(source, module.imports, -1, 0, 0);
+	const ShiftedPasses shifted{
+		TranslatePass(source, module.imports, -1, 0, 1),
+		TranslatePass(source, module.imports, -1, 0, 2)};
+	CheckSameLayout(original, shifted.once, 1);
+	CheckSameLayout(original, shifted.twice, 2);
+	AddRelocations(original, shifted, Relocation::k_module_base, module.relocations);
+
+	for (std::size_t i = 0; i < module.imports.size(); ++i)
+	{
+		const int import_index = static_cast<int>(i);
+		const ShiftedPasses imported{
+			TranslatePass(source, module.imports, import_index, 1, 0),
+			TranslatePass(source, module.imports, import_index, 2, 0)};
+		CheckSameLayout(original, imported.once, 0);
+		CheckSameLayout(original, imported.twice, 0);
+		AddRelocations(original, imported, import_index, module.relocations);
+	}
+
+	module.words = original.words;
+	module.size = original.end_address;
+	for (const auto& word : module.words)
+	{
+		module.size = std::max(module.size, word.original_address + 1);
+	}
+	module.start_address = original.start_address;
+	module.start_relocatable = (shifted.once.start_address != original.start_address);
+
+	std::unordered_map<std::string, std::pair<int, int>> shifted_symbols;
+	for (const auto& symbol_value : shifted.once.symbols)
+	{
+		shifted_symbols[symbol_value.first].first = symbol_value.second.value().value();
+	}
+	for (const auto& symbol_value : shifted.twice.symbols)
+	{
+		shifted_symbols[symbol_value.first].second = symbol_value.second.value().value();
+	}
+
+	for (const auto& symbol_value : original.symbols)
+	{
+		const auto& name = symbol_value.first;
+		if (IsInternalConstant(name)
+			|| (std::find(module.imports.cbegin(), module.imports.cend(), name) != module.imports.cend()))
+		{
+			continue;
+		}
+
+		// Symbols like `HALF EQU LABEL/2` are neither absolute nor
+		// relocatable (for any LABEL), hence are not exported
+		const auto value = symbol_value.second.value().value();
+		const auto shifted_values = shifted_symbols.at(name);
+		const bool absolute = (shifted_values.first == value)
+			&& (shifted_values.second == value);
+		const bool relocatable = (shifted_values.first == (value + 1))
+			&& (shifted_values.second == (value + 2));
+		if (absolute || relocatable)
+		{
+			module.exports.push_back(ExportedSymbol{
+				name, symbol_value.second, relocatable});
+		}
+	}
+
+	std::sort(module.relocations.begin(), module.relocations.end(),
+		[](const Relocation& lhs, const Relocation& rhs)
+	{
+		return (lhs.word_index < rhs.word_index);
+	});
+	return module;
+}
+
+void WriteObjectModule(std::ostream& out, const ObjectModule& module)
+{
+	std::string buffer;
+	BinaryWriter writer{buffer};
+	writer.bytes(k_magic.data(), k_magic.size());
+	writer.u32(ObjectModule::k_version);
+	writer.i32(module.start_address);
+	writer.u32(module.start_relocatable ? 1 : 0);
+	writer.i32(module.size);
+	writer.u32(static_cast<std::uint32_t>(module.words.size()));
+	writer.u32(static_cast<std::uint32_t>(module.relocations.size()));
+	writer.u32(static_cast<std::uint32_t>(module.imports.size()));
+	writer.u32(static_cast<std::uint32_t>(module.exports.size()));
+
+	for (const auto& word : module.words)
+	{
+		writer.i32(word.original_address);
+		writer.u32(PackWord(word.value));
+	}
+	for (const auto& relocation : module.relocations)
+	{
+		writer.u32(static_cast<std::uint32_t>(relocation.word_index));
+		writer.u32(static_cast<std::uint32_t>(relocation.kind));
+		writer.i32(relocation.import_index);
+	}
+	for (const auto& name : module.imports)
+	{
+		writer.u32(static_cast<std::uint32_t>(name.size()));
+		writer.bytes(name.data(), name.size());
+	}
+	for (const auto& symbol : module.exports)
+	{
+		writer.u32(static_cast<std::uint32_t>(symbol.name.size()));
+		writer.bytes(symbol.name.data(), symbol.name.size());
+		writer.u32(PackWord(symbol.value));
+		writer.u32(symbol.relocatable ? 1 : 0);
+	}
+
+	out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+ObjectModule ReadObjectModule(std::istream& in)
+{
+	const std::string buffer = ReadAll(in);
+	BinaryReader<ObjectModuleError> reader{buffer.data(), buffer.size()};
+
+	const char* magic = reader.take(k_magic.size());
+	if (!std::equal(k_magic.cbegin(), k_magic.cend(), magic))
+	{
+		throw ObjectModuleError{"invalid signature"};
+	}
+	if (reader.u32() != ObjectModule::k_version)
+	{
+		throw ObjectModuleError{"unsupported version"};
+	}
+
+	ObjectModule module;
+	module.start_address = reader.i32();
+	module.start_relocatable = (reader.u32() != 0);
+	module.size = reader.i32();
+	const std::size_t words_count = reader.u32();
+	const std::size_t relocations_count = reader.u32();
+	const std::size_t imports_count = reader.u32();
+	const std::size_t exports_count = reader.u32();
+	if ((module.size < 0)
+		|| (module.size > static_cast<int>(mix::Computer::k_memory_words_count)))
+	{
+		throw ObjectModuleError{"invalid module size"};
+	}
+
+	// Counts are checked before anything is allocated for them
+	auto check_count = [&](std::size_t count, std::size_t min_record_size, const char* what)
+	{
+		if (count > (reader.remaining() / min_record_size))
+		{
+			throw ObjectModuleError{std::string{"invalid "} + what + " count"};
+		}
+	};
+
+	auto read_name = [&]()
+	{
+		const std::size_t length = reader.u32();
+		return std::string{reader.take(length), length};
+	};
+
+	check_count(words_count, k_word_record_size, "words");
+	module.words.resize(words_count);
+	for (auto& word : module.words)
+	{
+		word.original_address = reader.i32();
+		word.value = UnpackWord(reader.u32());
+	}
+	check_count(relocations_count, 12, "relocations");
+	module.relocations.resize(relocations_count);
+	for (auto& relocation : module.relocations)
+	{
+		relocation.word_index = reader.u32();
+		const std::uint32_t kind = reader.u32();
+		relocation.kind = static_cast<RelocationKind>(kind);
+		relocation.import_index = reader.i32();
+		if ((kind > static_cast<std::uint32_t>(RelocationKind::Word))
+			|| (relocation.word_index >= words_count)
+			|| (relocation.import_index >= static_cast<int>(imports_count))
+			|| (relocation.import_index < Relocation::k_module_base))
+		{
+			throw ObjectModuleError{"invalid relocation"};
+		}
+	}
+	check_count(imports_count, 4, "imports");
+	module.imports.reserve(imports_count);
+	for (std::size_t i = 0; i < imports_count; ++i)
+	{
+		module.imports.push_back(read_name());
+	}
+	check_count(exports_count, 12, "exports");
+	module.exports.reserve(exports_count);
+	for (std::size_t i = 0; i < exports_count; ++i)
+	{
+		ExportedSymbol symbol;
+		symbol.name = read_name();
+		symbol.value = UnpackWord(reader.u32());
+		symbol.relocatable = (reader.u32() != 0);
+		module.exports.push_back(std::move(symbol));
+	}
+	return module;
+}
+
+TranslatedProgram LinkModules(const std::vector<ObjectModule>& modules,
+	int base_address /*= 0*/)
+{
+	// 1. Layout: modules one after another
+	std::vector<int> bases;
+	int next_base = base_address;
+	for (const auto& module : modules)
+	{
+		bases.push_back(next_base);
+		next_base += module.size;
+	}
+	if (next_base > static_cast<int>(mix::Computer::k_memory_words_count))
+	{
+		throw LinkError{"program does not fit into memory"};
+	}
+
+	// 2. Global symbols. Ones defined differently by few modules
+	// (e.g., usual `LOOP` label) are private to each module
+	std::unordered_map<std::string, int> symbols;
+	std::unordered_set<std::string> ambiguous_symbols;
+	for (std::size_t i = 0; i < modules.size(); ++i)
+	{
+		for (const auto& symbol : modules[i].exports)
+		{
+			const int value = symbol.value.value().value()
+				+ (symbol.relocatable ? bases[i] : 0);
+			const auto inserted = symbols.emplace(symbol.name, value);
+			if (!inserted.second && (inserted.first->second != value))
+			{
+				ambiguous_symbols.insert(symbol.name);
+			}
+		}
+	}
+
+	// 3. Words with relocations applied
+	TranslatedProgram program;
+	for (std::size_t i = 0; i < modules.size(); ++i)
+	{
+		const auto& module = modules[i];
+		std::vector<int> imports;
+		for (const auto& name : module.imports)
+		{
+			if (ambiguous_symbols.count(name) > 0)
+			{
+				throw LinkError{"ambiguous symbol " + name};
+			}
+			const auto it = symbols.find(name);
+			if (it == symbols.end())
+			{
+				throw LinkError{"undefined symbol " + name};
+			}
+			imports.push_back(it->second);
+		}
+
+		std::vector<TranslatedWord> words = module.words;
+		for (const auto& relocation : module.relocations)
+		{
+			const int delta = (relocation.import_index == Relocation::k_module_base)
+				? bases[i]
+				: imports[static_cast<std::size_t>(relocation.import_index)];
+			Relocate(words[relocation.word_index].value, relocation.kind, delta);
+		}
+
+		for (auto& word : words)
+		{
+			word.original_address += bases[i];
+			program.commands.push_back(word);
+		}
+	}
+
+	if (!modules.empty())
+	{
+		program.start_address = modules.front().start_address
+			+ (modules.front().start_relocatable ? bases.front() : 0);
+	}
+	return program;
+}
+
+} // namespace mixal
@@ -2,10 +2,14 @@
 #include <mixal/exceptions.h>
 
 #include <mix/word.h>
+#include <mix/byte.h>
 #include <mix/command.h>
 
 #include <core/utils.h>
 
+#include <array>
+
+#include <cstdint>
 #include <cassert>
 
 namespace mixal {
@@ -19,7 +23,7 @@ struct Data
 };
 
 // Commands with same id should be grouped together
-// to simplify QueryOperationInfo() search
+// to simplify SearchCommand()
 const Data k_operations_info[] =
 {
     {OperationId::NOP,   0,  WordField::FromByte(0)},
@@ -196,30 +200,8 @@ OperationInfo MakeInfo(const Data& data)
     return info;
 }
 
-} // namespace
-
-OperationInfo QueryOperationInfo(const Operation& op)
-{
-    for (const Data& info : k_operations_info)
-    {
-        if (info.id == op.id())
-        {
-            return MakeInfo(info);
-        }
-    }
-    throw InvalidOperationId(op.id());
-}
-
-OperationInfo QueryOperationInfo(const mix::Word& w)
+const Data* SearchCommand(int id, const WordField& field)
 {
-    return QueryOperationInfo(mix::Command(w));
-}
-
-OperationInfo QueryOperationInfo(const mix::Command& cmd)
-{
-    const int id = static_cast<int>(cmd.id());
-    const WordField field = cmd.word_field();
-
     const std::size_t count = core::ArraySize(k_operations_info);
     std::size_t start = count;
     for (std::size_t i = 0; i < count; ++i)
@@ -253,8 +235,82 @@ OperationInfo QueryOperationInfo(const mix::Command& cmd)
         }
         ++start;
     }
+    return found;
+}
+
+constexpr std::size_t k_byte_values_count = mix::Byte::k_values_count;
+constexpr std::uint8_t k_no_info = 0xff;
+
+static_assert(core::ArraySize(k_operations_info) < k_no_info,
+    "Index of operation does not fit into table");
+
+// Indexes in `k_operations_info`, so both queries are single lookup
+struct OperationsLookup
+{
+    std::array<std::uint8_t, core::ArraySize(k_operations_info)> by_operation{};
+    // [command id][field byte]
+    std::array<std::array<std::uint8_t, k_byte_values_count>, k_byte_values_count> by_command{};
+
+    OperationsLookup()
+    {
+        by_operation.fill(k_no_info);
+        for (std::size_t i = 0; i < core::ArraySize(k_operations_info); ++i)
+        {
+            const auto id = static_cast<std::size_t>(k_operations_info[i].id);
+            assert(id < by_operation.size());
+            by_operation[id] = static_cast<std::uint8_t>(i);
+        }
+
+        for (std::size_t id = 0; id < k_byte_values_count; ++id)
+        {
+            for (std::size_t field = 0; field < k_byte_values_count; ++field)
+            {
+                const Data* data = SearchCommand(static_cast<int>(id), WordField::FromByte(field));
+                by_command[id][field] = data
+                    ? static_cast<std::uint8_t>(data - k_operations_info)
+                    : k_no_info;
+            }
+        }
+    }
+};
+
+const OperationsLookup& GetOperationsLookup()
+{
+    static const OperationsLookup lookup;
+    return lookup;
+}
+
+} // namespace
+
+OperationInfo QueryOperationInfo(const Operation& op)
+{
+    const auto& by_operation = GetOperationsLookup().by_operation;
+    const auto index = static_cast<std::size_t>(op.id());
+    if ((op.id() == OperationId::Unknown)
+        || (index >= by_operation.size())
+        || (by_operation[index] == k_no_info))
+    {
+        throw InvalidOperationId(op.id());
+    }
+    return MakeInfo(k_operations_info[by_operation[index]]);
+}
+
+OperationInfo QueryOperationInfo(const mix::Word& w)
+{
+    return QueryOperationInfo(mix::Command(w));
+}
+
+OperationInfo QueryOperationInfo(const mix::Command& cmd)
+{
+    const std::size_t id = cmd.id();
+    const std::size_t field = cmd.field();
+    if ((id >= k_byte_values_count) || (field >= k_byte_values_count))
+    {
+        return OperationInfo{};
+    }
 
-    return found ? MakeInfo(*found) : OperationInfo{};
+    const auto index = GetOperationsLookup().by_command[id][field];
+    return (index != k_no_info) ? MakeInfo(k_operations_info[index]) : OperationInfo{};
 }
 
 } // namespace mixal
@@ -0,0 +1,87 @@
+#include <mixal/parallel_translator.h>
+#include <mixal/line_translator.h>
+
+#include <core/thread_pool.h>
+
+#include <algorithm>
+#include <exception>
+
+using namespace mixal;
+using namespace mixal_parse;
+
+namespace {
+
+struct ParsedLine
+{
+	std::optional<LineParser> parser;
+	// Parse error is reported only when line is reached by translation,
+	// so errors after END (or after previous error) are not visible
+	std::exception_ptr error;
+};
+
+void ParseLines(const SourceBuffer& source, std::size_t begin, std::size_t end,
+	std::vector<ParsedLine>& parsed)
+{
+	const auto& lines = source.lines();
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		try
+		{
+			parsed[i].parser = ParseLine(lines[i]);
+		}
+		catch (...)
+		{
+			parsed[i].error = std::current_exception();
+		}
+	}
+}
+
+std::vector<ParsedLine> ParseAllLines(const SourceBuffer& source,
+	const ParallelTranslateOptions& options)
+{
+	const std::size_t count = source.lines().size();
+	const std::size_t chunk = std::max<std::size_t>(options.chunk_lines, 1);
+
+	std::vector<ParsedLine> parsed(count);
+	if (count <= chunk)
+	{
+		ParseLines(source, 0, count, parsed);
+		return parsed;
+	}
+
+	core::ThreadPool pool{options.threads_count};
+	for (std::size_t begin = 0; begin < count; begin += chunk)
+	{
+		const std::size_t end = std::min(begin + chunk, count);
+		pool.submit([&source, &parsed, begin, end]()
+		{
+			ParseLines(source, begin, end, parsed);
+		});
+	}
+	pool.wait();
+	return parsed;
+}
+
+} // namespace
+
+namespace mixal {
+
+TranslatedProgram TranslateProgramParallel(const SourceBuffer& source,
+	const ParallelTranslateOptions& options /*= {}*/)
+{
+	const auto parsed = ParseAllLines(source, options);
+
+	Translator translator;
+	translator.set_literals_pooling(options.literals_pooling);
+	return TranslateLinesUntilEnd(parsed.size(), [&](std::size_t index)
+	{
+		const auto& line = parsed[index];
+		if (line.error)
+		{
+			std::rethrow_exception(line.error);
+		}
+		return TranslateParsedLine(translator, line.parser);
+	}).program;
+}
+
+} // namespace mixal
@@ -0,0 +1,246 @@
+#include <mixal/program_image.h>
+#include <mixal/line_translator.h>
+#include <mixal/exceptions.h>
+
+#include "internal/binary_io.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <array>
+
+#include <cassert>
+
+using namespace mixal;
+using namespace mixal::internal;
+
+namespace {
+
+const std::array<char, 8> k_magic{{'M', 'I', 'X', 'I', 'M', 'A', 'G', 'E'}};
+
+std::string CacheFileName(std::uint64_t source_hash, LiteralsPooling literals_pooling)
+{
+	std::ostringstream name;
+	name << std::hex << std::setw(16) << std::setfill('0') << source_hash
+		<< ".v" << ProgramImage::k_version
+		<< ".t" << Translator::k_version;
+	if (literals_pooling != LiteralsPooling::Disabled)
+	{
+		name << ".p" << static_cast<int>(literals_pooling);
+	}
+	name << ".miximage";
+	return name.str();
+}
+
+std::optional<ProgramImage> TryReadCachedImage(const std::filesystem::path& path,
+	std::uint64_t source_hash)
+{
+	std::ifstream in{path, std::ios_base::binary};
+	if (!in)
+	{
+		return std::nullopt;
+	}
+
+	try
+	{
+		auto image = ReadProgramImage(in);
+		if (image.source_hash == source_hash)
+		{
+			return image;
+		}
+	}
+	catch (const std::exception&)
+	{
+		// Any broken cache file (including one that asks for too much
+		// memory) just means that the source is translated again
+	}
+	return std::nullopt;
+}
+
+void TryWriteCachedImage(const std::filesystem::path& path, const ProgramImage& image)
+{
+	std::error_code error;
+	std::filesystem::create_directories(path.parent_path(), error);
+
+	// Written to unique temporary file first, so concurrent
+	// readers never see partially written image
+	auto temp_path = path;
+	temp_path += ".tmp" + std::to_string(std::random_device{}());
+	{
+		std::ofstream out{temp_path, std::ios_base::binary | std::ios_base::trunc};
+		if (!out)
+		{
+			return;
+		}
+		WriteProgramImage(out, image);
+		if (!out.flush())
+		{
+			out.close();
+			std::filesystem::remove(temp_path, error);
+			return;
+		}
+	}
+
+	std::filesystem::rename(temp_path, path, error);
+	if (error)
+	{
+		std::filesystem::remove(temp_path, error);
+	}
+}
+
+} // namespace
+
+namespace mixal {
+
+std::uint64_t HashSource(std::string_view text)
+{
+	std::uint64_t hash = 14695981039346656037ull;
+	for (char ch : text)
+	{
+		hash ^= static_cast<unsigned char>(ch);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+ProgramImage TranslateProgramImage(const SourceBuffer& source,
+	LiteralsPooling literals_pooling /*= LiteralsPooling::Disabled*/)
+{
+	ProgramImage image;
+	image.source_hash = HashSource(source.text());
+
+	Translator translator;
+	translator.set_literals_pooling(literals_pooling);
+	const auto& lines = source.lines();
+	auto translated = TranslateLinesUntilEnd(lines.size(), [&](std::size_t index)
+	{
+		return TranslateParsedLine(translator, ParseLine(lines[index]));
+	});
+
+	// Translated lines are in source order, so line number is index + 1
+	image.program = std::move(translated.program);
+	image.lines = std::move(translated.words_lines);
+	for (int& line : image.lines)
+	{
+		++line;
+	}
+
+	for (const auto& symbol_value : translator.defined_symbols())
+	{
+		image.symbols.push_back(std::make_pair(
+			std::string{symbol_value.first.name()}, symbol_value.second));
+	}
+	return image;
+}
+
+void WriteProgramImage(std::ostream& out, const ProgramImage& image)
+{
+	assert(image.lines.size() == image.program.commands.size());
+
+	std::string buffer;
+	buffer.reserve(k_magic.size() + 32
+		+ image.program.commands.size() * (k_word_record_size + 4));
+
+	BinaryWriter writer{buffer};
+	writer.bytes(k_magic.data(), k_magic.size());
+	writer.u32(ProgramImage::k_version);
+	writer.u64(image.source_hash);
+	writer.i32(image.program.start_address);
+	writer.u32(static_cast<std::uint32_t>(image.program.commands.size()));
+	writer.u32(static_cast<std::uint32_t>(image.symbols.size()));
+
+	for (const auto& word : image.program.commands)
+	{
+		writer.i32(word.original_address);
+		writer.u32(PackWord(word.value));
+	}
+	for (int line : image.lines)
+	{
+		writer.i32(line);
+	}
+	for (const auto& symbol : image.symbols)
+	{
+		writer.u32(static_cast<std::uint32_t>(symbol.first.size()));
+		writer.bytes(symbol.first.data(), symbol.first.size());
+		writer.u32(PackWord(symbol.second));
+	}
+
+	out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+ProgramImage ReadProgramImage(std::istream& in)
+{
+	const std::string buffer = ReadAll(in);
+	BinaryReader<CorruptedProgramImage> reader{buffer.data(), buffer.size()};
+
+	const char* magic = reader.take(k_magic.size());
+	if (!std::equal(k_magic.cbegin(), k_magic.cend(), magic))
+	{
+		throw CorruptedProgramImage{"invalid signature"};
+	}
+	if (reader.u32() != ProgramImage::k_version)
+	{
+		throw CorruptedProgramImage{"unsupported version"};
+	}
+
+	ProgramImage image;
+	image.source_hash = reader.u64();
+	image.program.start_address = reader.i32();
+	const std::size_t words_count = reader.u32();
+	const std::size_t symbols_count = reader.u32();
+
+	// Whole section is checked once, records are decoded in place
+	if (words_count > reader.remaining() / k_word_record_size)
+	{
+		throw CorruptedProgramImage{"invalid words count"};
+	}
+	const char* words = reader.take(words_count * k_word_record_size);
+	BinaryReader<CorruptedProgramImage> words_reader{words, words_count * k_word_record_size};
+	image.program.commands.resize(words_count);
+	for (auto& word : image.program.commands)
+	{
+		word.original_address = words_reader.i32();
+		word.value = UnpackWord(words_reader.u32());
+	}
+
+	image.lines.resize(words_count);
+	for (auto& line : image.lines)
+	{
+		line = reader.i32();
+	}
+
+	// Each symbol takes at least its length and word
+	if (symbols_count > reader.remaining() / 8)
+	{
+		throw CorruptedProgramImage{"invalid symbols count"};
+	}
+	image.symbols.reserve(symbols_count);
+	for (std::size_t i = 0; i < symbols_count; ++i)
+	{
+		const std::size_t length = reader.u32();
+		std::string name{reader.take(length), length};
+		image.symbols.push_back(std::make_pair(std::move(name), UnpackWord(reader.u32())));
+	}
+	return image;
+}
+
+ProgramImage LoadOrTranslateProgramImage(const SourceBuffer& source,
+	const std::string& cache_dir,
+	LiteralsPooling literals_pooling /*= LiteralsPooling::Disabled*/)
+{
+	const auto source_hash = HashSource(source.text());
+	const auto path = std::filesystem::path{cache_dir}
+		/ CacheFileName(source_hash, literals_pooling);
+	if (auto cached = TryReadCachedImage(path, source_hash))
+	{
+		return std::move(*cached);
+	}
+
+	auto image = TranslateProgramImage(source, literals_pooling);
+	TryWriteCachedImage(path, image);
+	return image;
+}
+
+} // namespace mixal
@@ -0,0 +1,74 @@
+#include <mixal/source_buffer.h>
+#include <mixal/exceptions.h>
+
+#include <fstream>
+#include <iterator>
+
+using namespace mixal;
+
+namespace {
+
+std::vector<std::string_view> SplitLines(std::string_view text)
+{
+	std::vector<std::string_view> lines;
+	std::size_t begin = 0;
+	while (begin < text.size())
+	{
+		auto end = text.find('\n', begin);
+		if (end == std::string_view::npos)
+		{
+			end = text.size();
+		}
+		lines.push_back(text.substr(begin, end - begin));
+		begin = end + 1;
+	}
+	return lines;
+}
+
+} // namespace
+
+/*explicit*/ SourceBuffer::SourceBuffer(std::string text)
+	: text_{std::make_unique<const std::string>(std::move(text))}
+	, lines_{SplitLines(*text_)}
+{
+}
+
+/*static*/ SourceBuffer SourceBuffer::FromFile(const std::string& file_path)
+{
+	std::ifstream in{file_path, std::ios_base::binary};
+	if (!in)
+	{
+		throw SourceFileOpenError{file_path};
+	}
+	return FromStream(in);
+}
+
+/*static*/ SourceBuffer SourceBuffer::FromStream(std::istream& in)
+{
+	std::string text;
+	// Single allocation when size of the stream is known
+	const auto begin = in.tellg();
+	if (in.seekg(0, std::ios_base::end))
+	{
+		const auto end = in.tellg();
+		in.seekg(begin);
+		if ((begin >= 0) && (end > begin))
+		{
+			text.reserve(static_cast<std::size_t>(end - begin));
+		}
+	}
+	in.clear();
+
+	text.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+	return SourceBuffer{std::move(text)};
+}
+
+std::string_view SourceBuffer::text() const
+{
+	return *text_;
+}
+
+const std::vector<std::string_view>& SourceBuffer::lines() const
+{
+	return lines_;
+}
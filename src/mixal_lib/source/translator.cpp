@@ -3,14 +3,21 @@
 #include <mixal/operations_calculator.h>
 #include <mixal/operation_info.h>
 
+#include "internal/symbols_table.hpp"
+#include "internal/words_arena.hpp"
+
 #include <mix/char_table.h>
 #include <mix/word_field.h>
 #include <mix/command.h>
+#include <mix/exceptions.h>
 
 #include <functional>
 #include <algorithm>
+#include <unordered_map>
 #include <list>
 
+#include <cstdint>
+
 using namespace mixal;
 
 namespace {
@@ -32,6 +39,44 @@ struct AddressTransformation
 	Address address;
 };
 
+bool HasLocalReference(const FutureTranslatedWord& word, LocalSymbolId id)
+{
+	return any_of(word.forward_references.cbegin(), word.forward_references.cend(),
+		[&](const Symbol& symbol)
+	{
+		return symbol.is_local() && (symbol.local_id() == id);
+	});
+}
+
+// Unique key for each value (including sign of zero)
+std::uint64_t WordKey(const Word& word)
+{
+	const std::uint64_t negative = (word.sign() == mix::Sign::Negative) ? 1 : 0;
+	return ((std::uint64_t{word.abs_value()} << 1) | negative);
+}
+
+// Value of literal does not depend on the place where it's evaluated
+bool IsAddressIndependent(const Expression& expr)
+{
+	return std::none_of(expr.tokens().cbegin(), expr.tokens().cend(),
+		[](const Expression::Token& token)
+	{
+		const auto& basic_expr = token.basic_expr;
+		return basic_expr.is_current_address()
+			|| (basic_expr.is_symbol() && basic_expr.as_symbol().is_local());
+	});
+}
+
+bool IsAddressIndependent(const WValue& wvalue)
+{
+	return std::all_of(wvalue.tokens().cbegin(), wvalue.tokens().cend(),
+		[](const WValue::Token& token)
+	{
+		return IsAddressIndependent(token.expression)
+			&& (!token.field || IsAddressIndependent(*token.field));
+	});
+}
+
 template<typename K, typename V>
 FlatMap<K, V> CombineFlatMaps(FlatMap<K, V>&& fm1, FlatMap<K, V>&& fm2)
 {
@@ -56,6 +101,8 @@ struct Translator::Impl
 	Word evaluate(const Number& n) const;
 	Word evaluate(const BasicExpression& expr) const;
 	Word evaluate(const Expression& expr) const;
+	Word evaluate_tokens(const Expression& expr,
+		std::size_t begin, std::size_t end, Word value) const;
 	Word evaluate(const WValue& wvalue) const;
 
 	FutureTranslatedWordRef translate_MIX(
@@ -70,16 +117,22 @@ struct Translator::Impl
 	TranslatedWord translate_CON(const WValue& address, const Label& label);
 	TranslatedWord translate_CON(const Word& value, const Label& label);
 	TranslatedWord translate_ALF(const Text& text, const Label& label);
+	FutureTranslatedWordRef hold_word(const TranslatedWord& word);
 	EndCommandGeneratedCode translate_END(const WValue& address, const Label& label);
 
 	void set_current_address(int address, bool notify = true);
 	int current_address() const;
 
+	void set_literals_pooling(LiteralsPooling pooling);
+	void set_resolve_errors_handler(ResolveErrorsHandler handler);
+
 	void define_symbol(const Symbol& symbol, const Word& value);
 	Word query_defined_symbol(const Symbol& symbol, int near_address) const;
 
 	bool is_defined_symbol(const Symbol& symbol, int near_address) const;
 
+	FlatMap<Symbol, Word> defined_symbols() const;
+
 private:
 	WordField evaluate_wvalue_field(const std::optional<Expression>& field_expr) const;
 
@@ -100,28 +153,40 @@ private:
 
 	void increase_current_address();
 
-	void prepare_local_addresses(Addresses& addresses) const;
-	void prepare_local_addresses(DefinedLocalSymbols& local_symbols) const;
-
 	AddressTransformation transform_address(const Address& address);
 
 	Byte index_to_byte(const Index& index, const OperationInfo& op_info) const;
 	Byte field_to_byte(const Field& field, const OperationInfo& op_info) const;
 
 	FutureTranslatedWordRef process_mix_translation(
-		FutureTranslatedWordShared&& partial_result,
+		FutureTranslatedWord& partial_result,
 		const Address& address, Byte I, Byte F, Byte C);
 
 	int evaluate_address(const Address& address) const;
+	void fold_known_address_part(FutureTranslatedWord& word) const;
+	int evaluate_unresolved_address(const FutureTranslatedWord& word) const;
 
 	Word make_mix_command(int address, Byte I, Byte F, Byte C) const;
 
-	void update_unresolved_references();
-	bool try_resolve_previous_word(FutureTranslatedWord& translation_word);
+	void add_unresolved_word(FutureTranslatedWord& word);
+	std::vector<FutureTranslatedWord*>& usual_symbol_references(const Symbol& symbol);
+	void resolve_usual_symbol_references(const Symbol& symbol);
+	void resolve_local_symbol_references(const Symbol& symbol);
+	bool try_resolve_previous_word(FutureTranslatedWord& translation_word,
+		bool report_errors = false);
 	void resolve_previous_word(FutureTranslatedWord& translation_word);
+	void resolve_previous_word_or_report(FutureTranslatedWord& translation_word);
+	void report_local_reference_error(const Symbol& symbol);
+	template<typename Callable>
+	void try_or_report(const FutureTranslatedWord* word, Callable callable) const;
+	const FutureTranslatedWord* find_constant_user(const Symbol& constant) const;
+	void remove_resolved_words();
 
 	std::string_view make_constant(const WValue& wvalue);
+	std::optional<Word> try_evaluate_constant_now(const WValue& wvalue) const;
 	bool is_internal_constant(const Symbol& symbol) const;
+	bool try_define_pooled_constant(const Symbol& symbol, const Word& value,
+		std::unordered_map<std::uint64_t, int>& constant_addresses);
 
 	std::vector<Symbol> collect_unresolved_symbols() const;
 	FlatMap<Symbol, Word> evaluate_unresolved_symbols(std::vector<Symbol> symbols) const;
@@ -133,17 +198,39 @@ private:
 private:
 	int current_address_;
 
-	DefinedSymbols defined_symbols_;
-	DefinedLocalSymbols defined_local_symbols_;
+	internal::UsualSymbolsTable defined_symbols_;
+	internal::LocalSymbolsTable defined_local_symbols_;
 
-	std::vector<FutureTranslatedWordShared> unresolved_words_;
+	// All words of the program, handed out as `FutureTranslatedWordRef`
+	internal::WordsArena words_;
+	// In order of translation, may contain already resolved words
+	// (see `remove_resolved_words()`). Words are owned by `words_`
+	std::vector<FutureTranslatedWord*> unresolved_words_;
+	std::size_t resolved_words_count_;
+	// Reverse index: words that wait for definition of given symbol
+	// (usual symbols are indexed by interned id)
+	std::vector<std::vector<FutureTranslatedWord*>> usual_symbol_references_;
+	std::map<LocalSymbolId, std::vector<FutureTranslatedWord*>> local_symbol_references_;
 
 	// Note: using this as a storage for created on the heap
 	// runtime strings for names of internal constants.
 	// These strings are referenced by `Expression` of `Address`
 	// after transformation (see `transform_address()`)
 	std::list<std::string> constants_storage_;
-	FlatMap<Symbol, WValue> constant_to_value_;
+	// Value is cached when literal could be evaluated at definition time
+	struct LiteralConstant
+	{
+		WValue wvalue;
+		std::optional<Word> value;
+	};
+	FlatMap<Symbol, LiteralConstant> constant_to_value_;
+
+	LiteralsPooling literals_pooling_;
+	// Names of literal constants that were evaluated at definition time
+	std::unordered_map<std::uint64_t, std::string_view> pooled_constants_;
+	// Addresses of CON words (for `LiteralsPooling::SameValuesAndCON`)
+	std::unordered_map<std::uint64_t, int> con_words_;
+	ResolveErrorsHandler resolve_errors_handler_;
 };
 
 struct Translator::Impl::ChangeTemporaryCurrentAddress
@@ -232,6 +319,11 @@ TranslatedWord Translator::translate_ALF(const Text& text, const Label& label /*
 	return impl->translate_ALF(text, label);
 }
 
+FutureTranslatedWordRef Translator::hold_word(const TranslatedWord& word)
+{
+	return impl->hold_word(word);
+}
+
 Translator::EndCommandGeneratedCode Translator::translate_END(
 	const WValue& address, const Label& label /*= {}*/)
 {
@@ -243,6 +335,16 @@ void Translator::set_current_address(int address)
 	return impl->set_current_address(address);
 }
 
+void Translator::set_literals_pooling(LiteralsPooling pooling)
+{
+	return impl->set_literals_pooling(pooling);
+}
+
+void Translator::set_resolve_errors_handler(ResolveErrorsHandler handler)
+{
+	return impl->set_resolve_errors_handler(std::move(handler));
+}
+
 int Translator::current_address() const
 {
 	return impl->current_address();
@@ -263,6 +365,11 @@ bool Translator::is_defined_symbol(const Symbol& symbol, int near_address /*= -1
 	return impl->is_defined_symbol(symbol, near_address);
 }
 
+FlatMap<Symbol, Word> Translator::defined_symbols() const
+{
+	return impl->defined_symbols();
+}
+
 Word Translator::Impl::evaluate(const Text& text) const
 {
 	const auto& data = text.data();
@@ -358,19 +465,25 @@ WordField Translator::Impl::evaluate_wvalue_field(const std::optional<Expression
 Word Translator::Impl::evaluate(const Expression& expr) const
 {
 	assert(expr.is_valid());
-	const auto& tokens = expr.tokens();
-
-	auto left_token = tokens[0];
+	const auto& first_token = expr.tokens()[0];
 	auto value = CalculateOptionalUnaryOperation(
-		left_token.unary_op, evaluate(left_token.basic_expr));
+		first_token.unary_op, evaluate(first_token.basic_expr));
+	return evaluate_tokens(expr, 1, expr.tokens().size(), std::move(value));
+}
+
+// Continues evaluation of `[begin, end)` tokens, where `value`
+// is the result of all tokens before `begin`
+Word Translator::Impl::evaluate_tokens(const Expression& expr,
+	std::size_t begin, std::size_t end, Word value) const
+{
+	const auto& tokens = expr.tokens();
+	assert((begin > 0) && (end <= tokens.size()));
 
-	for (std::size_t i = 1, count = tokens.size(); i < count; ++i)
+	for (std::size_t i = begin; i < end; ++i)
 	{
-		auto right_token = tokens[i];
+		const Expression::Token& left_token = tokens[i - 1];
 		value = CalculateBinaryOperation(
-			*left_token.binary_op, std::move(value), evaluate(right_token.basic_expr));
-
-		left_token = right_token;
+			*left_token.binary_op, std::move(value), evaluate(tokens[i].basic_expr));
 	}
 
 	return value;
@@ -403,25 +516,33 @@ int Translator::Impl::current_address() const
 	return current_address_;
 }
 
+void Translator::Impl::set_literals_pooling(LiteralsPooling pooling)
+{
+	literals_pooling_ = pooling;
+}
+
+void Translator::Impl::set_resolve_errors_handler(ResolveErrorsHandler handler)
+{
+	resolve_errors_handler_ = std::move(handler);
+}
+
 void Translator::Impl::define_symbol(const Symbol& symbol, const Word& value)
 {
 	if (symbol.is_local())
 	{
 		define_local_symbol(symbol, value.value());
+		resolve_local_symbol_references(symbol);
 	}
 	else
 	{
 		define_usual_symbol(symbol, value);
+		resolve_usual_symbol_references(symbol);
 	}
-
-	update_unresolved_references();
 }
 
 void Translator::Impl::define_usual_symbol(const Symbol& symbol, const Word& value)
 {
-	const auto it = defined_symbols_.insert(std::make_pair(symbol, value));
-	const bool inserted = it.second;
-	if (!inserted)
+	if (!defined_symbols_.define(symbol, value))
 	{
 		throw DuplicateSymbolDefinitionError{symbol, value};
 	}
@@ -433,23 +554,7 @@ void Translator::Impl::define_local_symbol(const Symbol& symbol, int address)
 	{
 		throw InvalidLocalSymbolDefinition{symbol};
 	}
-	const auto id = symbol.local_id();
-	auto& addresses = defined_local_symbols_[id];
-	addresses.push_back(address);
-	prepare_local_addresses(addresses);
-}
-
-void Translator::Impl::prepare_local_addresses(Addresses& addresses) const
-{
-	sort(addresses.begin(), addresses.end());
-}
-
-void Translator::Impl::prepare_local_addresses(DefinedLocalSymbols& local_symbols) const
-{
-	for (auto& addresses : local_symbols)
-	{
-		prepare_local_addresses(addresses.second);
-	}
+	defined_local_symbols_.define(symbol.local_id(), address);
 }
 
 Word Translator::Impl::query_defined_symbol(const Symbol& symbol, int near_address) const
@@ -466,13 +571,13 @@ Word Translator::Impl::query_defined_symbol(const Symbol& symbol, int near_addre
 
 Word Translator::Impl::query_usual_symbol(const Symbol& symbol) const
 {
-	auto it = defined_symbols_.find(symbol);
-	if (it == defined_symbols_.end())
+	const Word* value = defined_symbols_.find(symbol);
+	if (!value)
 	{
 		throw UndefinedSymbolError{symbol};
 	}
 
-	return it->second;
+	return *value;
 }
 
 Word Translator::Impl::query_local_symbol(const Symbol& symbol, int near_address) const
@@ -497,23 +602,13 @@ Word Translator::Impl::query_local_symbol(const Symbol& symbol, int near_address
 
 const int* Translator::Impl::find_local_symbol(const Symbol& symbol, int near_address) const
 {
-	const auto addresses_it = defined_local_symbols_.find(symbol.local_id());
-	if (addresses_it == defined_local_symbols_.end())
-	{
-		return nullptr;
-	}
-
-	// Note: depends on sort criteria in `prepare_local_addresses()`
-	const auto& addresses = addresses_it->second;
 	if (symbol.kind() == LocalSymbolKind::Backward)
 	{
-		auto it = lower_bound(addresses.crbegin(), addresses.crend(), near_address, std::greater<>{});
-		return (it != addresses.crend()) ? &*it : nullptr;
+		return defined_local_symbols_.find_backward(symbol.local_id(), near_address);
 	}
 	else if (symbol.kind() == LocalSymbolKind::Forward)
 	{
-		auto it = lower_bound(addresses.cbegin(), addresses.cend(), near_address);
-		return (it != addresses.cend()) ? &*it : nullptr;
+		return defined_local_symbols_.find_forward(symbol.local_id(), near_address);
 	}
 
 	return nullptr;
@@ -531,9 +626,19 @@ bool Translator::Impl::is_defined_symbol(const Symbol& symbol, int near_address)
 	}
 }
 
+FlatMap<Symbol, Word> Translator::Impl::defined_symbols() const
+{
+	FlatMap<Symbol, Word> symbols;
+	defined_symbols_.for_each([&](std::string_view name, const Word& value)
+	{
+		symbols.push_back(std::make_pair(Symbol{name}, value));
+	});
+	return symbols;
+}
+
 bool Translator::Impl::is_defined_usual_symbol(const Symbol& symbol) const
 {
-	return (defined_symbols_.find(symbol) != defined_symbols_.end());
+	return (defined_symbols_.find(symbol) != nullptr);
 }
 
 bool Translator::Impl::is_defined_local_symbol(const Symbol& symbol, int near_address) const
@@ -571,7 +676,13 @@ void Translator::Impl::translate_ORIG(const WValue& value, const Label& label)
 
 TranslatedWord Translator::Impl::translate_CON(const WValue& wvalue, const Label& label)
 {
-	return translate_CON(evaluate(wvalue), label);
+	auto translated = translate_CON(evaluate(wvalue), label);
+	if (literals_pooling_ == LiteralsPooling::SameValuesAndCON)
+	{
+		// First CON word with given value is used
+		con_words_.emplace(WordKey(translated.value), translated.original_address);
+	}
+	return translated;
 }
 
 TranslatedWord Translator::Impl::translate_CON(const Word& value, const Label& label)
@@ -594,6 +705,13 @@ TranslatedWord Translator::Impl::translate_ALF(const Text& text, const Label& la
 	return result;
 }
 
+FutureTranslatedWordRef Translator::Impl::hold_word(const TranslatedWord& word)
+{
+	auto& future_word = words_.emplace(word.original_address);
+	future_word.value = word.value;
+	return FutureTranslatedWordRef{&future_word};
+}
+
 // Note: this function _may be_ not exception safe. This means
 // that after any kind of exception/error `Translator` state will be in
 // undetermined state (TODO: investigate)
@@ -608,16 +726,38 @@ Translator::EndCommandGeneratedCode Translator::Impl::translate_END(
 	EndCommandGeneratedCode code;
 	code.start_address = evaluate(value).value(k_end_command_address_field);
 
+	std::unordered_map<std::uint64_t, int> constant_addresses;
 	for (const auto& symbol_value : symbols)
 	{
 		const auto symbol = symbol_value.first;
+		if (try_define_pooled_constant(symbol, symbol_value.second, constant_addresses))
+		{
+			continue;
+		}
+		if (resolve_errors_handler_ && symbol.is_local())
+		{
+			// Can't be defined on END (see `define_local_symbol()`),
+			// error belongs to the words that refer to it
+			report_local_reference_error(symbol);
+			continue;
+		}
+
 		const auto translated = translate_CON(symbol_value.second, symbol);
+		if ((literals_pooling_ != LiteralsPooling::Disabled) && is_internal_constant(symbol))
+		{
+			constant_addresses.emplace(WordKey(translated.value), translated.original_address);
+		}
 
 		code.defined_symbols.push_back(std::make_pair(symbol, translated));
 	}
 
 	constant_to_value_.clear();
+	pooled_constants_.clear();
+	con_words_.clear();
 	unresolved_words_.clear();
+	resolved_words_count_ = 0;
+	usual_symbol_references_.clear();
+	local_symbol_references_.clear();
 
 	define_label_if_valid(label, Word(current_address()));
 	return code;
@@ -634,15 +774,15 @@ FutureTranslatedWordRef Translator::Impl::translate_MIX(
 	Byte F = field_to_byte(field, command_info);
 
 	const auto original_address = current_address();
-	const auto transformation = transform_address(address);
-	auto future_word = std::make_shared<FutureTranslatedWord>(
+	auto transformation = transform_address(address);
+	auto& future_word = words_.emplace(
 		original_address,
-		transformation.forward_references);
+		std::move(transformation.forward_references));
 
 	define_label_if_valid(label, Word(original_address));
 
 	auto result = process_mix_translation(
-		std::move(future_word), transformation.address, I, F, C);
+		future_word, transformation.address, I, F, C);
 
 	// Note: when resolving forwarding references later and translating
 	// `Address` expression to its value, we should replace
@@ -704,12 +844,84 @@ AddressTransformation Translator::Impl::transform_address(const Address& address
 	return transformed;
 }
 
+bool Translator::Impl::try_define_pooled_constant(const Symbol& symbol, const Word& value,
+	std::unordered_map<std::uint64_t, int>& constant_addresses)
+{
+	if ((literals_pooling_ == LiteralsPooling::Disabled) || !is_internal_constant(symbol))
+	{
+		return false;
+	}
+
+	const auto key = WordKey(value);
+	auto it = con_words_.find(key);
+	if (it == con_words_.end())
+	{
+		it = constant_addresses.find(key);
+		if (it == constant_addresses.end())
+		{
+			return false;
+		}
+	}
+
+	// No word is generated, literal refers to existing one
+	define_symbol(symbol, Word(it->second));
+	return true;
+}
+
+std::optional<Word> Translator::Impl::try_evaluate_constant_now(const WValue& wvalue) const
+{
+	if (!IsAddressIndependent(wvalue))
+	{
+		return std::nullopt;
+	}
+
+	for (const auto& token : wvalue.tokens())
+	{
+		for (const auto& expr_token : token.expression.tokens())
+		{
+			const auto& basic_expr = expr_token.basic_expr;
+			if (basic_expr.is_symbol() && !is_defined_usual_symbol(basic_expr.as_symbol()))
+			{
+				return std::nullopt;
+			}
+		}
+	}
+
+	try
+	{
+		return evaluate(wvalue);
+	}
+	catch (const MixalException&)
+	{
+		// Reported on END, as for not pooled constant
+		return std::nullopt;
+	}
+}
+
 std::string_view Translator::Impl::make_constant(const WValue& wvalue)
 {
+	// Literals with the same value share single internal constant.
+	// Others (e.g., with forward references) are merged on END
+	const std::optional<Word> value = try_evaluate_constant_now(wvalue);
+	const bool pooling = (literals_pooling_ != LiteralsPooling::Disabled);
+	if (pooling && value)
+	{
+		const auto it = pooled_constants_.find(WordKey(*value));
+		if (it != pooled_constants_.end())
+		{
+			return it->second;
+		}
+	}
+
 	const auto id = constants_storage_.size() + 1;
 	constants_storage_.push_back("@CON" + std::to_string(id));
 	std::string_view name = constants_storage_.back();
-	constant_to_value_.push_back(std::make_pair(Symbol{name}, wvalue));
+	constant_to_value_.push_back(std::make_pair(Symbol{name},
+		LiteralConstant{wvalue, value}));
+	if (pooling && value)
+	{
+		pooled_constants_.emplace(WordKey(*value), name);
+	}
 	return name;
 }
 
@@ -759,6 +971,56 @@ int Translator::Impl::evaluate_address(const Address& address) const
 	return 0;
 }
 
+void Translator::Impl::fold_known_address_part(FutureTranslatedWord& word) const
+{
+	if (!word.unresolved_address.has_expression())
+	{
+		return;
+	}
+
+	const auto& expr = word.unresolved_address.expression();
+	const auto& references = word.forward_references;
+	const auto& tokens = expr.tokens();
+	const auto first_unknown = std::find_if(tokens.cbegin(), tokens.cend(),
+		[&](const Expression::Token& token)
+	{
+		const auto& basic_expr = token.basic_expr;
+		return basic_expr.is_symbol() &&
+			(std::find(references.cbegin(), references.cend(),
+				basic_expr.as_symbol()) != references.cend());
+	});
+	const auto count = static_cast<std::size_t>(first_unknown - tokens.cbegin());
+	if ((count == 0) || (count == tokens.size()))
+	{
+		return;
+	}
+
+	try
+	{
+		const auto& first_token = tokens[0];
+		auto value = CalculateOptionalUnaryOperation(
+			first_token.unary_op, evaluate(first_token.basic_expr));
+		word.folded_address = evaluate_tokens(expr, 1, count, std::move(value));
+		word.folded_tokens_count = count;
+	}
+	catch (const MixalException&)
+	{
+		// Reported when the word is resolved, as without folding
+	}
+}
+
+int Translator::Impl::evaluate_unresolved_address(const FutureTranslatedWord& word) const
+{
+	if (word.folded_tokens_count == 0)
+	{
+		return evaluate_address(word.unresolved_address);
+	}
+
+	const auto& expr = word.unresolved_address.expression();
+	return evaluate_tokens(expr, word.folded_tokens_count,
+		expr.tokens().size(), word.folded_address).value();
+}
+
 Word Translator::Impl::make_mix_command(int address, Byte I, Byte F, Byte C) const
 {
 	// #TODO: check address/index and so on validness
@@ -772,34 +1034,108 @@ Word Translator::Impl::make_mix_command(int address, Byte I, Byte F, Byte C) con
 }
 
 FutureTranslatedWordRef Translator::Impl::process_mix_translation(
-	FutureTranslatedWordShared&& partial_result,
+	FutureTranslatedWord& partial_result,
 	const Address& address, Byte I, Byte F, Byte C)
 {
-	if (partial_result->is_ready())
+	if (partial_result.is_ready())
 	{
-		partial_result->value = make_mix_command(
+		partial_result.value = make_mix_command(
 			evaluate_address(address), I, F, C);
-		return std::move(partial_result);
+		return FutureTranslatedWordRef{&partial_result};
 	}
 
-	partial_result->value = make_mix_command(0, I, F, C);
-	partial_result->unresolved_address = address;
-	unresolved_words_.push_back(partial_result);
-	return std::move(partial_result);
+	partial_result.value = make_mix_command(0, I, F, C);
+	partial_result.unresolved_address = address;
+	fold_known_address_part(partial_result);
+	if (!try_resolve_previous_word(partial_result))
+	{
+		add_unresolved_word(partial_result);
+	}
+	return FutureTranslatedWordRef{&partial_result};
 }
 
-void Translator::Impl::update_unresolved_references()
+void Translator::Impl::add_unresolved_word(FutureTranslatedWord& future_word)
 {
-	// Can't use generic lambda since bug in GCC 4.8.4 (Travis CI)
-	// https://gcc.gnu.org/bugzilla/show_bug.cgi?id=61636
-	unresolved_words_.erase(remove_if(begin(unresolved_words_), end(unresolved_words_),
-		[&](const FutureTranslatedWordShared& future_word)
+	FutureTranslatedWord* word = &future_word;
+	for (const auto& symbol : word->forward_references)
 	{
-		return try_resolve_previous_word(*future_word);
-	}) , end(unresolved_words_));
+		auto& words = symbol.is_local()
+			? local_symbol_references_[symbol.local_id()]
+			: usual_symbol_references(symbol);
+		// The same symbol can be referenced few times by the word
+		if (words.empty() || (words.back() != word))
+		{
+			words.push_back(word);
+		}
+	}
+	unresolved_words_.push_back(word);
+}
+
+std::vector<FutureTranslatedWord*>& Translator::Impl::usual_symbol_references(
+	const Symbol& symbol)
+{
+	const auto id = defined_symbols_.interner().intern(symbol.name());
+	if (id >= usual_symbol_references_.size())
+	{
+		usual_symbol_references_.resize(id + 1);
+	}
+	return usual_symbol_references_[id];
+}
+
+void Translator::Impl::resolve_usual_symbol_references(const Symbol& symbol)
+{
+	const auto id = defined_symbols_.interner().find(symbol.name());
+	if (id >= usual_symbol_references_.size())
+	{
+		return;
+	}
+
+	const auto words = std::move(usual_symbol_references_[id]);
+	usual_symbol_references_[id].clear();
+
+	for (FutureTranslatedWord* word : words)
+	{
+		auto& references = word->forward_references;
+		references.erase(remove(begin(references), end(references), symbol), end(references));
+		if (word->is_ready())
+		{
+			resolve_previous_word_or_report(*word);
+			++resolved_words_count_;
+		}
+	}
+
+	remove_resolved_words();
+}
+
+void Translator::Impl::resolve_local_symbol_references(const Symbol& symbol)
+{
+	const auto it = local_symbol_references_.find(symbol.local_id());
+	if (it == local_symbol_references_.end())
+	{
+		return;
+	}
+
+	// Forward reference is resolved only for words that are placed
+	// before (or at) new definition's address, others still wait
+	auto& words = it->second;
+	const auto id = symbol.local_id();
+	words.erase(remove_if(begin(words), end(words),
+		[&](FutureTranslatedWord* word)
+	{
+		if (try_resolve_previous_word(*word, true/*report errors*/))
+		{
+			++resolved_words_count_;
+			return true;
+		}
+		// Still waits for other symbols
+		return !HasLocalReference(*word, id);
+	}), end(words));
+
+	remove_resolved_words();
 }
 
-bool Translator::Impl::try_resolve_previous_word(FutureTranslatedWord& translation_word)
+bool Translator::Impl::try_resolve_previous_word(FutureTranslatedWord& translation_word,
+	bool report_errors /*= false*/)
 {
 	auto& references = translation_word.forward_references;
 	const auto original_address = translation_word.original_address;
@@ -812,20 +1148,108 @@ bool Translator::Impl::try_resolve_previous_word(FutureTranslatedWord& translati
 
 	if (translation_word.is_ready())
 	{
-		resolve_previous_word(translation_word);
+		if (report_errors)
+		{
+			resolve_previous_word_or_report(translation_word);
+		}
+		else
+		{
+			resolve_previous_word(translation_word);
+		}
 		return true;
 	}
 
 	return false;
 }
 
+void Translator::Impl::resolve_previous_word_or_report(FutureTranslatedWord& translation_word)
+{
+	try_or_report(&translation_word, [&]()
+	{
+		resolve_previous_word(translation_word);
+	});
+}
+
+// Reference is dropped, so each word is reported once
+// (the same symbol may be listed few times)
+void Translator::Impl::report_local_reference_error(const Symbol& symbol)
+{
+	for (FutureTranslatedWord* word : unresolved_words_)
+	{
+		auto& references = word->forward_references;
+		const auto it = std::remove(references.begin(), references.end(), symbol);
+		if (it != references.end())
+		{
+			references.erase(it, references.end());
+			resolve_errors_handler_(ResolveError{FutureTranslatedWordRef{word},
+				std::make_exception_ptr(InvalidLocalSymbolReference{symbol})});
+		}
+	}
+}
+
+// Error of `callable` is passed to the handler (if any) instead of being thrown
+template<typename Callable>
+void Translator::Impl::try_or_report(const FutureTranslatedWord* word, Callable callable) const
+{
+	if (!resolve_errors_handler_)
+	{
+		callable();
+		return;
+	}
+
+	try
+	{
+		callable();
+	}
+	catch (const MixalException&)
+	{
+		resolve_errors_handler_(ResolveError{FutureTranslatedWordRef{word}, std::current_exception()});
+	}
+	catch (const mix::MixException&)
+	{
+		resolve_errors_handler_(ResolveError{FutureTranslatedWordRef{word}, std::current_exception()});
+	}
+}
+
+// First word that refers to literal constant (it waits for
+// the constant till END). Null if there is no such word
+const FutureTranslatedWord* Translator::Impl::find_constant_user(const Symbol& constant) const
+{
+	for (const FutureTranslatedWord* word : unresolved_words_)
+	{
+		const auto& references = word->forward_references;
+		if (std::find(references.cbegin(), references.cend(), constant) != references.cend())
+		{
+			return word;
+		}
+	}
+	return nullptr;
+}
+
+void Translator::Impl::remove_resolved_words()
+{
+	// Amortized: resolved words are dropped only when there are many
+	// of them, so each definition does not scan all unresolved words
+	if ((resolved_words_count_ * 2) < unresolved_words_.size())
+	{
+		return;
+	}
+
+	unresolved_words_.erase(remove_if(begin(unresolved_words_), end(unresolved_words_),
+		[](const FutureTranslatedWord* future_word)
+	{
+		return future_word->is_ready();
+	}), end(unresolved_words_));
+	resolved_words_count_ = 0;
+}
+
 void Translator::Impl::resolve_previous_word(FutureTranslatedWord& translation_word)
 {
 	assert(translation_word.is_ready());
 	const auto original_address = translation_word.original_address;
 	ChangeTemporaryCurrentAddress _{*this, original_address};
 	mix::Command command{translation_word.value};
-	command.change_address(evaluate_address(translation_word.unresolved_address));
+	command.change_address(evaluate_unresolved_address(translation_word));
 	translation_word.value = command.to_word();
 }
 
@@ -833,10 +1257,31 @@ Translator::Impl::Impl(const DefinedSymbols& symbols,
 	const DefinedLocalSymbols& local_symbols,
 	int current_address)
 		: current_address_{current_address}
-		, defined_symbols_{symbols}
-		, defined_local_symbols_{local_symbols}
+		, defined_symbols_()
+		, defined_local_symbols_()
+		, words_()
+		, unresolved_words_()
+		, resolved_words_count_{0}
+		, usual_symbol_references_()
+		, local_symbol_references_()
+		, constants_storage_()
+		, constant_to_value_()
+		, literals_pooling_{LiteralsPooling::Disabled}
+		, pooled_constants_()
+		, con_words_()
 {
-	prepare_local_addresses(defined_local_symbols_);
+	for (const auto& symbol_value : symbols)
+	{
+		defined_symbols_.define(symbol_value.first, symbol_value.second);
+	}
+
+	for (const auto& id_addresses : local_symbols)
+	{
+		for (int address : id_addresses.second)
+		{
+			defined_local_symbols_.define(id_addresses.first, address);
+		}
+	}
 }
 
 std::vector<Symbol> Translator::Impl::collect_unresolved_symbols() const
@@ -872,10 +1317,18 @@ FlatMap<Symbol, Word> Translator::Impl::evaluate_unresolved_symbols(
 FlatMap<Symbol, Word> Translator::Impl::evaluate_constants() const
 {
 	FlatMap<Symbol, Word> symbol_to_value;
-	for (const auto& constant_wvalue : constant_to_value_)
+	for (const auto& constant : constant_to_value_)
 	{
-		symbol_to_value.push_back(std::make_pair(constant_wvalue.first,
-			evaluate(constant_wvalue.second)));
+		const auto& literal = constant.second;
+		Word value = literal.value.value_or(Word{});
+		if (!literal.value)
+		{
+			try_or_report(find_constant_user(constant.first), [&]()
+			{
+				value = evaluate(literal.wvalue);
+			});
+		}
+		symbol_to_value.push_back(std::make_pair(constant.first, value));
 	}
 	return symbol_to_value;
 }
@@ -0,0 +1,51 @@
+#pragma once
+#include <mixal_parse/config.h>
+#include <mixal_parse/line_parser.h>
+
+#include <core/line_reader.h>
+
+#include <functional>
+
+namespace mixal_parse {
+
+// Line of the source produced by `ParsedLinesStream`
+struct ParsedLine
+{
+	// Without '\n'. Valid as long as `core::LineReader` says
+	// (see `core::LinesLifetime`)
+	std::string_view text;
+	// Starting from 1
+	std::size_t number{0};
+	// Null for empty line (or line with only white spaces) and for
+	// the line that failed to parse. Valid until the next line is read
+	const LineParser* parser{nullptr};
+
+	bool is_empty() const;
+	bool is_invalid() const;
+};
+
+// Parses lines of `core::LineReader` one by one, reusing single `LineParser`,
+// so nothing is copied or allocated per line
+class MIXAL_PARSE_LIB_EXPORT ParsedLinesStream
+{
+public:
+	// Called for every line before it's parsed, can change the line in place
+	using LineTransform = std::function<void (core::Span<char> line)>;
+
+	// When `trim_lines` is set, line is parsed without leading and trailing
+	// white spaces (e.g., '\r' of CRLF line endings), `ParsedLine::text`
+	// is not trimmed
+	explicit ParsedLinesStream(core::LineReader& reader,
+		LineTransform transform = {}, bool trim_lines = false);
+
+	// Returns false at the end of input
+	bool next(ParsedLine& line);
+
+private:
+	core::LineReader& reader_;
+	LineTransform transform_;
+	bool trim_lines_;
+	LineParser parser_;
+};
+
+} // namespace mixal_parse
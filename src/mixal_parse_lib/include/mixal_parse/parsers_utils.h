@@ -73,6 +73,10 @@ bool IsSymbolChar(char ch);
 MIXAL_PARSE_LIB_EXPORT
 bool IsBasicExpressionChar(char ch);
 
+// Same as `std::isspace()` in "C" locale
+MIXAL_PARSE_LIB_EXPORT
+bool IsWhiteSpaceChar(char ch);
+
 MIXAL_PARSE_LIB_EXPORT
 bool IsCompletedUnaryOperation(const std::string_view& str);
 
@@ -98,6 +102,10 @@ LocalSymbolId ParseLocalSymbolId(const std::string_view& str);
 MIXAL_PARSE_LIB_EXPORT
 std::size_t SkipLeftWhiteSpaces(const std::string_view& str, std::size_t offset = 0);
 
+// Position of first space character or `str.size()` otherwise
+MIXAL_PARSE_LIB_EXPORT
+std::size_t FindFirstWhiteSpace(const std::string_view& str, std::size_t offset = 0);
+
 MIXAL_PARSE_LIB_EXPORT
 std::size_t ExpectFirstNonWhiteSpaceChar(char ch, const std::string_view& str, std::size_t offset = 0);
 
@@ -1,6 +1,8 @@
 #pragma once
 #include <mixal_parse/types/expression.h>
 
+#include <variant>
+
 namespace mixal_parse {
 
 class Address
@@ -19,9 +21,7 @@ public:
 	bool has_literal_constant() const;
 
 private:
-	// #TODO: C++17 std::variant<Expression, WValue>
-	Expression expr_;
-	WValue wvalue_;
+	std::variant<std::monostate, Expression, WValue> value_;
 };
 
 } // namespace mixal_parse
@@ -31,31 +31,32 @@ private:
 namespace mixal_parse {
 
 inline Address::Address()
-	: expr_{}
-	, wvalue_{}
+	: value_{}
 {
 }
 
 inline Address::Address(const Expression& expr)
-	: expr_{expr}
-	, wvalue_{}
+	: value_{expr}
 {
 }
 
 inline Address::Address(const WValue& wvalue)
-	: expr_{}
-	, wvalue_{wvalue}
+	: value_{wvalue}
 {
 }
 
 inline const Expression& Address::expression() const
 {
-	return expr_;
+	static const Expression k_empty{};
+	const auto* expr = std::get_if<Expression>(&value_);
+	return expr ? *expr : k_empty;
 }
 
 inline const WValue& Address::w_value() const
 {
-	return wvalue_;
+	static const WValue k_empty{};
+	const auto* wvalue = std::get_if<WValue>(&value_);
+	return wvalue ? *wvalue : k_empty;
 }
 
 inline bool Address::empty() const
@@ -65,12 +66,12 @@ inline bool Address::empty() const
 
 inline bool Address::has_expression() const
 {
-	return expr_.is_valid();
+	return expression().is_valid();
 }
 
 inline bool Address::has_w_value() const
 {
-	return wvalue_.is_valid();
+	return w_value().is_valid();
 }
 
 inline bool Address::has_literal_constant() const
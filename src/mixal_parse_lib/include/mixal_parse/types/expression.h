@@ -2,8 +2,7 @@
 #include <mixal_parse/types/basic_expression.h>
 
 #include <core/optional.h>
-
-#include <vector>
+#include <core/small_vector.h>
 
 #include <cassert>
 
@@ -19,14 +18,18 @@ public:
 		std::optional<BinaryOperation> binary_op;
 	};
 
-	const std::vector<Token>& tokens() const;
+	// Most of expressions are short (e.g., `LABEL+1`),
+	// those are kept without allocations
+	using Tokens = core::SmallVector<Token, 2>;
+
+	const Tokens& tokens() const;
 
 	void add_token(Token&& token);
 
 	bool is_valid() const;
 
 private:
-	std::vector<Token> tokens_;
+	Tokens tokens_;
 };
 
 class WValue
@@ -37,18 +40,21 @@ public:
 		Expression expression;
 		std::optional<Expression> field;
 	};
+
+	// Usually W-value is single expression
+	using Tokens = core::SmallVector<Token, 1>;
 	
-	const std::vector<Token>& tokens() const;
+	const Tokens& tokens() const;
 
 	void add_token(Token&& token);
 
 	bool is_valid() const;
 
 private:
-	std::vector<Token> tokens_;
+	Tokens tokens_;
 };
 
-inline const std::vector<Expression::Token>& Expression::tokens() const
+inline const Expression::Tokens& Expression::tokens() const
 {
 	return tokens_;
 }
@@ -73,7 +79,7 @@ inline bool Expression::is_valid() const
 		!tokens_.back().binary_op;
 }
 
-inline const std::vector<WValue::Token>& WValue::tokens() const
+inline const WValue::Tokens& WValue::tokens() const
 {
 	return tokens_;
 }
@@ -5,7 +5,6 @@
 #include <algorithm>
 
 #include <cassert>
-#include <cctype>
 
 using namespace mixal_parse;
 
@@ -122,7 +121,7 @@ char ExpressionParser::move_to_next_char()
 void ExpressionParser::put_char_back()
 {
 	if ((parse_pos_ != 0) &&
-		!std::isspace(parse_str_[parse_pos_ - 1]))
+		!IsWhiteSpaceChar(parse_str_[parse_pos_ - 1]))
 	{
 		--parse_pos_;
 		return;
@@ -133,7 +132,7 @@ void ExpressionParser::put_char_back()
 
 void ExpressionParser::skip_white_spaces()
 {
-	while (!eof() && std::isspace(parse_str_[parse_pos_]))
+	while (!eof() && IsWhiteSpaceChar(parse_str_[parse_pos_]))
 	{
 		++parse_pos_;
 	}
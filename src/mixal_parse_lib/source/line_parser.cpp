@@ -2,10 +2,7 @@
 
 #include <core/string.h>
 
-#include <algorithm>
-
 #include <cassert>
-#include <cctype>
 
 using namespace mixal_parse;
 
@@ -19,6 +16,29 @@ bool IsCommentBeginning(const std::string_view& str)
 		(str.front() == k_comment_begin_char);
 }
 
+// Word of the line (till the next white space), the same that
+// `OperationParser` reads. Empty at the end of the line
+struct Token
+{
+	std::size_t begin{0};
+	std::size_t end{0};
+};
+
+Token NextToken(const std::string_view& str, std::size_t offset)
+{
+	Token token;
+	token.begin = SkipLeftWhiteSpaces(str, offset);
+	token.end = FindFirstWhiteSpace(str, token.begin);
+	return token;
+}
+
+bool IsOperationToken(const std::string_view& str, const Token& token)
+{
+	return (token.begin != token.end)
+		&& (OperationIdFromString(str.substr(token.begin, token.end - token.begin))
+			!= OperationId::Unknown);
+}
+
 } // namespace
 
 std::size_t LineParser::do_parse_stream(std::string_view str, std::size_t offset)
@@ -35,62 +55,55 @@ std::size_t LineParser::do_parse_stream(std::string_view str, std::size_t offset
 		return str.size();
 	}
 
-	auto pos = try_parse_line_without_label(str, first_char_pos);
-	if (IsInvalidStreamPosition(pos))
+	// Basically, because we do not separate LABEL and OPERATION columns
+	// with single space, but with multiple spaces, there are
+	// more logic to determine what is LABEL and what is OPERATION.
+	// Decision is made with one word of lookahead:
+	// if first word is not OPERATION, it's LABEL. Otherwise it still can be
+	// the name of the LABEL (syntax does not disallow such behavior):
+	// when next word is OPERATION too and there is something after it
+	// (i.e., we have next line: "OPERATION OPERATION ADDRESS stuff"),
+	// first OPERATION is LABEL
+	const Token first = NextToken(str, first_char_pos);
+	if (!IsOperationToken(str, first))
 	{
-		pos = try_parse_line_with_label(str, first_char_pos);
+		return parse_line_with_label(str, first_char_pos);
+	}
+
+	const Token second = NextToken(str, first.end);
+	const bool second_is_operation = IsOperationToken(str, second);
+	if (second_is_operation
+		&& !core::Trim(str.substr(second.end)).empty())
+	{
+		return parse_line_with_label(str, first_char_pos);
+	}
+
+	const auto pos = parse_line_without_label(str, first_char_pos);
+	if (IsInvalidStreamPosition(pos) && second_is_operation)
+	{
+		// "OPERATION OPERATION" line, where second OPERATION is not
+		// valid ADDRESS for the first one
+		return parse_line_with_label(str, first_char_pos);
 	}
-	
 	return pos;
 }
 
-std::size_t LineParser::try_parse_line_without_label(
+std::size_t LineParser::parse_line_without_label(
 	const std::string_view& str,
-	std::size_t offset,
-	bool fallback_to_label_parse /*= true*/)
+	std::size_t offset)
 {
-	// Basically, because we do not separate LABEL and OPERATION columns
-	// with single space, but with multiple spaces, there are
-	// more logic to determine what is LABEL and what is OPERATION.
-	// We are trying to parse line like it starts with OPERATION and if we failed
-	// then return and lets the caller tries to parse line that starts with LABEL
-
-	OperationParser op_parser_of_label;
-	const auto op_end = op_parser_of_label.parse_stream(str, offset);
+	OperationParser op_parser;
+	const auto op_end = op_parser.parse_stream(str, offset);
 	if (IsInvalidStreamPosition(op_end))
 	{
 		return InvalidStreamPosition();
 	}
 
-	if (fallback_to_label_parse)
-	{
-		// Ok, LINE starts with valid OPERATION, but it can be the name
-		// of the LABEL (syntax does not disallow such behavior).
-		// We are trying to parse next token as OPERATION also.
-		// 
-		// If it is OPERATION (e.g., we have next LINE: "OPERATION OPERATION"),
-		// then choose the way where first OPERATION is LABEL and
-		// return to the caller to parse line that starts with LABEL
-		// 
-		// (Small note: do this only if line has something after our
-		// 2nd OPERATION, i.e., we have next line: "OPERATION OPERATION ADDRESS stuff")
-		OperationParser op_parser;
-		const auto end = op_parser.parse_stream(str, op_end);
-		if (!IsInvalidStreamPosition(end))
-		{
-			const bool has_non_empty_address_column = !core::Trim(str.substr(end)).empty();
-			if (has_non_empty_address_column)
-			{
-				return InvalidStreamPosition();
-			}
-		}
-	}
-
-	operation_parser_ = std::move(op_parser_of_label);
+	operation_parser_ = std::move(op_parser);
 	return parse_address_str_with_comment(str, op_end);
 }
 
-std::size_t LineParser::try_parse_line_with_label(const std::string_view& str, std::size_t offset)
+std::size_t LineParser::parse_line_with_label(const std::string_view& str, std::size_t offset)
 {
 	LabelParser label_parser;
 	const auto label_end = label_parser.parse_stream(str, offset);
@@ -100,7 +113,7 @@ std::size_t LineParser::try_parse_line_with_label(const std::string_view& str, s
 	}
 	
 	label_parser_ = std::move(label_parser);
-	return try_parse_line_without_label(str, label_end, false/*do not go to label parsing*/);
+	return parse_line_without_label(str, label_end);
 }
 
 std::size_t LineParser::parse_address_str_with_comment(const std::string_view& str, std::size_t offset)
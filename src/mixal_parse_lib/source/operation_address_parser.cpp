@@ -1,7 +1,6 @@
 #include <mixal_parse/operation_address_parser.h>
 
 #include <cassert>
-#include <cctype>
 
 using namespace mixal_parse;
 
@@ -12,15 +11,15 @@ const std::size_t k_ALF_op_length = 5;
 bool ALFStartsWithOneSpace(const std::string_view& str, std::size_t offset)
 {
 	return (str.size() > (offset + 2)) &&
-		std::isspace(str[offset]) &&
-		!std::isspace(str[offset + 1]);
+		IsWhiteSpaceChar(str[offset]) &&
+		!IsWhiteSpaceChar(str[offset + 1]);
 }
 
 bool ALFStartsWithTwoSpaces(const std::string_view& str, std::size_t offset)
 {
 	return (str.size() > (offset + 3)) &&
-		std::isspace(str[offset]) &&
-		std::isspace(str[offset + 1]);
+		IsWhiteSpaceChar(str[offset]) &&
+		IsWhiteSpaceChar(str[offset + 1]);
 }
 
 bool IsValidALFText(const Text& /*alf_text*/)
@@ -0,0 +1,51 @@
+#include <mixal_parse/parsed_lines_stream.h>
+
+using namespace mixal_parse;
+
+bool ParsedLine::is_empty() const
+{
+	return core::Trim(text).empty();
+}
+
+bool ParsedLine::is_invalid() const
+{
+	return !parser && !is_empty();
+}
+
+/*explicit*/ ParsedLinesStream::ParsedLinesStream(core::LineReader& reader,
+	LineTransform transform /*= {}*/, bool trim_lines /*= false*/)
+		: reader_{reader}
+		, transform_{std::move(transform)}
+		, trim_lines_{trim_lines}
+		, parser_{}
+{
+}
+
+bool ParsedLinesStream::next(ParsedLine& line)
+{
+	core::Span<char> str;
+	if (!reader_.next_line(str))
+	{
+		return false;
+	}
+
+	if (transform_)
+	{
+		transform_(str);
+	}
+
+	line.text = std::string_view{str.data(), str.size()};
+	line.number = reader_.lines_count();
+	line.parser = nullptr;
+	if (line.is_empty())
+	{
+		return true;
+	}
+
+	const auto str_to_parse = trim_lines_ ? core::Trim(line.text) : line.text;
+	if (!IsInvalidStreamPosition(parser_.parse_stream(str_to_parse)))
+	{
+		line.parser = &parser_;
+	}
+	return true;
+}
@@ -2,10 +2,19 @@
 
 #include <sstream>
 #include <algorithm>
+#include <array>
 
-#include <cctype>
+#include <cstdint>
 #include <cassert>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  define MIXAL_PARSE_SSE2
+#  include <emmintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#endif
+
 namespace mixal_parse {
 
 extern const std::size_t k_max_symbol_length = 10;
@@ -28,15 +37,115 @@ namespace {
 
 const std::string_view k_local_symbols = "BHF";
 
+// Classes of characters (bit flags) to check any of them with single lookup
+enum CharClass : std::uint8_t
+{
+	k_white_space_char			= 1 << 0,
+	k_number_char				= 1 << 1,
+	// #TODO: get alpha-chars from MIX chars table
+	k_mix_alpha_char			= 1 << 2,
+	k_current_address_char		= 1 << 3,
+	// Should match `k_unary_operations`
+	k_unary_operation_char		= 1 << 4,
+	// Should match `k_binary_operations`
+	k_binary_operation_char		= 1 << 5,
+};
+
+constexpr void AddCharsClass(std::array<std::uint8_t, 256>& table,
+	std::string_view chars, CharClass char_class)
+{
+	for (char ch : chars)
+	{
+		table[static_cast<unsigned char>(ch)] |= char_class;
+	}
+}
+
+constexpr std::array<std::uint8_t, 256> MakeCharClassesTable()
+{
+	std::array<std::uint8_t, 256> table{};
+	// Same as `std::isspace()` in "C" locale
+	AddCharsClass(table, " \t\n\v\f\r", k_white_space_char);
+	AddCharsClass(table, "0123456789", k_number_char);
+	AddCharsClass(table, "ABCDEFGHIJKLMNOPQRSTUVWXYZ", k_mix_alpha_char);
+	AddCharsClass(table, "*", k_current_address_char);
+	AddCharsClass(table, "-+", k_unary_operation_char);
+	AddCharsClass(table, "-+*/:", k_binary_operation_char);
+	return table;
+}
+
+constexpr std::array<std::uint8_t, 256> k_char_classes = MakeCharClassesTable();
+
+bool HasCharClass(char ch, std::uint8_t char_class)
+{
+	return (k_char_classes[static_cast<unsigned char>(ch)] & char_class) != 0;
+}
+
 bool IsCurrentAddressChar(char ch)
 {
-	return (ch == k_current_address_marker);
+	return HasCharClass(ch, k_current_address_char);
 }
 
-bool IsMixAlphaCharacter(char symbol)
+bool IsMixAlphaCharacter(char ch)
 {
-	// #TODO: get alpha-chars from MIX chars table
-	return std::isalpha(symbol) && std::isupper(symbol);
+	return HasCharClass(ch, k_mix_alpha_char);
+}
+
+#if defined(MIXAL_PARSE_SSE2)
+constexpr std::size_t k_sse2_chars_count = 16;
+
+// Bit per each of 16 characters starting from `data`: 1 for white space
+unsigned WhiteSpacesMask(const char* data)
+{
+	const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+	const __m128i is_space = _mm_cmpeq_epi8(chars, _mm_set1_epi8(' '));
+	// ['\t'; '\r'] range: (ch - '\t') <= ('\r' - '\t') as unsigned
+	const __m128i shifted = _mm_sub_epi8(chars, _mm_set1_epi8('\t'));
+	const __m128i is_control = _mm_cmpeq_epi8(
+		_mm_min_epu8(shifted, _mm_set1_epi8('\r' - '\t')), shifted);
+	return static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(is_space, is_control)));
+}
+
+std::size_t FirstSetBit(unsigned mask)
+{
+	assert(mask != 0);
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward(&index, mask);
+	return index;
+#else
+	return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+// Position of first character that is (or is not) white space
+// starting from `offset` or `str.size()`
+std::size_t FindWhiteSpaceOrNot(const std::string_view& str, std::size_t offset, bool white_space)
+{
+	const std::size_t size = str.size();
+	std::size_t pos = offset;
+#if defined(MIXAL_PARSE_SSE2)
+	for (; (pos + k_sse2_chars_count) <= size; pos += k_sse2_chars_count)
+	{
+		unsigned mask = WhiteSpacesMask(str.data() + pos);
+		if (!white_space)
+		{
+			mask = ~mask & 0xffffu;
+		}
+		if (mask != 0)
+		{
+			return pos + FirstSetBit(mask);
+		}
+	}
+#endif
+	for (; pos < size; ++pos)
+	{
+		if (IsWhiteSpaceChar(str[pos]) == white_space)
+		{
+			return pos;
+		}
+	}
+	return size;
 }
 
 } // namespace
@@ -94,16 +203,8 @@ bool IsBasicExpression(const std::string_view& str)
 
 bool IsUnaryOperationBegin(char ch)
 {
-	for (auto unary_op : k_unary_operations)
-	{
-		assert(!unary_op.empty());
-		if (unary_op.front() == ch)
-		{
-			return true;
-		}
-	}
-
-	return false;
+	// All unary operations are single char
+	return IsUnaryOperationChar(ch);
 }
 
 bool IsNumberBegin(char ch)
@@ -125,43 +226,32 @@ bool IsBasicExpressionBegin(char ch)
 
 bool IsUnaryOperationChar(char ch)
 {
-	for (const auto& unary_op : k_unary_operations)
-	{
-		if (unary_op.find(ch) != std::string_view::npos)
-		{
-			return true;
-		}
-	}
-	return false;
+	return HasCharClass(ch, k_unary_operation_char);
 }
 
 bool IsBinaryOperationChar(char ch)
 {
-	for (const auto& binary_op : k_binary_operations)
-	{
-		if (binary_op.find(ch) != std::string_view::npos)
-		{
-			return true;
-		}
-	}
-	return false;
+	return HasCharClass(ch, k_binary_operation_char);
 }
 
 bool IsNumberChar(char ch)
 {
-	return std::isdigit(ch);
+	return HasCharClass(ch, k_number_char);
 }
 
 bool IsSymbolChar(char ch)
 {
-	return IsMixAlphaCharacter(ch) ||
-		IsNumberChar(ch);
+	return HasCharClass(ch, k_mix_alpha_char | k_number_char);
 }
 
 bool IsBasicExpressionChar(char ch)
 {
-	// IsSymbolChar() covers IsNumberChar()
-	return IsCurrentAddressChar(ch) || IsSymbolChar(ch);
+	return HasCharClass(ch, k_current_address_char | k_mix_alpha_char | k_number_char);
+}
+
+bool IsWhiteSpaceChar(char ch)
+{
+	return HasCharClass(ch, k_white_space_char);
 }
 
 bool IsCompletedUnaryOperation(const std::string_view& str)
@@ -209,12 +299,16 @@ std::size_t SkipLeftWhiteSpaces(const std::string_view& str, std::size_t offset
 		return str.size();
 	}
 
-	auto last_not_space = std::find_if_not(str.begin() + offset, str.end(), &isspace);
-	if (last_not_space == str.end())
+	return FindWhiteSpaceOrNot(str, offset, false/*not white space*/);
+}
+
+std::size_t FindFirstWhiteSpace(const std::string_view& str, std::size_t offset /*= 0*/)
+{
+	if (offset > str.size())
 	{
 		return str.size();
 	}
-	return static_cast<std::size_t>(std::distance(str.begin(), last_not_space));
+	return FindWhiteSpaceOrNot(str, offset, true/*white space*/);
 }
 
 std::size_t ExpectFirstNonWhiteSpaceChar(char ch, const std::string_view& str, std::size_t offset /*= 0*/)
@@ -2,16 +2,21 @@
 
 #include <core/utils.h>
 
-#include <cstring>
+#include <array>
+
+#include <cstdint>
 
 namespace mixal_parse {
 namespace {
 
-const struct
+struct OperationName
 {
-    const OperationId id;
-    const char* const name;
-} k_operation_str_table[] =
+    OperationId id;
+    std::string_view name;
+};
+
+// Ordered by id, so name of operation is found by index
+constexpr OperationName k_operation_str_table[] =
 {
     {OperationId::NOP, "NOP"},
     {OperationId::ADD, "ADD"},
@@ -180,34 +185,102 @@ const struct
 static_assert(core::ArraySize(k_operation_str_table) == static_cast<std::size_t>(OperationId::Count),
 	"Something wrong with OperationId mapping");
 
-} // namespace
+constexpr bool IsOrderedById()
+{
+    for (std::size_t i = 0; i < core::ArraySize(k_operation_str_table); ++i)
+    {
+        if (static_cast<std::size_t>(k_operation_str_table[i].id) != i)
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-std::string_view OperationIdToString(OperationId id)
+static_assert(IsOrderedById(), "k_operation_str_table should be ordered by id");
+
+// Perfect hash for operation names: seed is selected at compile time
+// so that all names land in different slots. Name is then found
+// with single hash computation and single string compare
+constexpr std::size_t k_names_hash_size = 4096;
+constexpr std::uint8_t k_no_operation = 0xff;
+
+static_assert(core::ArraySize(k_operation_str_table) < k_no_operation,
+	"Index of operation does not fit into slot");
+
+constexpr std::uint32_t HashName(std::string_view name, std::uint32_t seed)
 {
-    if ((id == OperationId::Unknown)
-        || (id == OperationId::Count))
+    // FNV-1a
+    std::uint32_t hash = 2166136261u ^ seed;
+    for (char c : name)
     {
-        return std::string_view();
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
     }
+    return hash ^ (hash >> 16);
+}
+
+struct NamesHashTable
+{
+    std::uint32_t seed = 0;
+    std::array<std::uint8_t, k_names_hash_size> slots{};
+    bool valid = false;
+};
 
-    for (const auto& info : k_operation_str_table)
+constexpr NamesHashTable MakeNamesHashTable()
+{
+    for (std::uint32_t seed = 0; seed < 1000; ++seed)
     {
-        if (info.id == id)
+        NamesHashTable table;
+        table.seed = seed;
+        for (std::size_t i = 0; i < k_names_hash_size; ++i)
+        {
+            table.slots[i] = k_no_operation;
+        }
+
+        table.valid = true;
+        for (std::size_t i = 0; i < core::ArraySize(k_operation_str_table); ++i)
+        {
+            const auto slot = HashName(k_operation_str_table[i].name, seed) % k_names_hash_size;
+            if (table.slots[slot] != k_no_operation)
+            {
+                table.valid = false;
+                break;
+            }
+            table.slots[slot] = static_cast<std::uint8_t>(i);
+        }
+        if (table.valid)
         {
-            return info.name;
+            return table;
         }
     }
-	return std::string_view();
+    return NamesHashTable{};
+}
+
+constexpr NamesHashTable k_names_hash_table = MakeNamesHashTable();
+
+static_assert(k_names_hash_table.valid, "Can't find perfect hash for operation names");
+
+} // namespace
+
+std::string_view OperationIdToString(OperationId id)
+{
+    const auto index = static_cast<std::size_t>(id);
+    if ((id == OperationId::Unknown)
+        || (index >= core::ArraySize(k_operation_str_table)))
+    {
+        return std::string_view();
+    }
+    return k_operation_str_table[index].name;
 }
 
 OperationId OperationIdFromString(std::string_view str)
 {
-    for (const auto& info : k_operation_str_table)
+    const auto slot = HashName(str, k_names_hash_table.seed) % k_names_hash_size;
+    const auto index = k_names_hash_table.slots[slot];
+    if ((index != k_no_operation)
+        && (k_operation_str_table[index].name == str))
     {
-        if (str == info.name)
-        {
-            return info.id;
-        }
+        return k_operation_str_table[index].id;
     }
 	return OperationId::Unknown;
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <mixal/types.h>
+#include <mixal/assembler_session.h>
 
 #include <vector>
 #include <string>
@@ -24,12 +25,19 @@ struct ProgramWithSource
     int start_address = -1;
 };
 
+// Only changed lines are translated again if possible (see
+// `mixal::AssemblerSession`) and only their words are written to memory,
+// so `mix` should keep memory of the previous load. Otherwise memory
+// is cleared and the whole program is loaded. `reload_memory` forces
+// full load (e.g., once program was running and could modify itself)
 ProgramWithSource LoadProgramFromSourceFile(
-    const std::string& file_name, mix::Computer* mix);
+    const std::string& file_name, mix::Computer* mix
+    , mixal::AssemblerSession* session, bool reload_memory);
 
 struct Debugger
 {
     ProgramWithSource program_;
+    mixal::AssemblerSession session_;
     bool loaded_ = false;
 
     std::stringstream device18_;
@@ -6,9 +6,18 @@
 #include <imgui.h>
 #include <imgui_stdlib.h>
 
+// Registers and devices are reset, memory is kept: program is either
+// loaded again or only patched (see `LoadProgramFromSourceFile()`)
 static void SetupIODevice(Debugger* debugger, mix::Computer* mix)
 {
-    *mix = mix::Computer();
+    mix::Computer computer;
+    for (int address = 0
+        , count = static_cast<int>(mix::Computer::k_memory_words_count)
+        ; address < count; ++address)
+    {
+        computer.set_memory(address, mix->memory(address));
+    }
+    *mix = std::move(computer);
     debugger->device18_.str(std::string());
     mix->replace_device(18
         , std::make_unique<mix::SymbolDevice>(
@@ -77,7 +86,10 @@ static void UIControlsModifyMix(UIMix* ui_mix, mix::Computer* mix, Debugger* deb
     if (ui_mix->controls_.load_from_file)
     {
         SetupIODevice(debugger, mix);
-        debugger->program_ = LoadProgramFromSourceFile(ui_mix->controls_.source_file_, mix);
+        const bool reload_memory = !debugger->loaded_
+            || (debugger->executed_instructions_count > 0);
+        debugger->program_ = LoadProgramFromSourceFile(ui_mix->controls_.source_file_, mix
+            , &debugger->session_, reload_memory);
         debugger->loaded_ = true;
         debugger->breakpoints_.clear();
         debugger->executed_instructions_count = 0;
@@ -1,14 +1,21 @@
 #include <mixui/debugger.h>
 
-#include <mixal/translator.h>
 #include <mixal/line_translator.h>
 
 #include <mix/computer.h>
 
 #include <fstream>
+#include <sstream>
 
 static void LoadProgram(const ProgramWithSource& program, mix::Computer* computer)
 {
+    // Nothing is left from previously loaded program
+    for (int address = 0
+        , count = static_cast<int>(mix::Computer::k_memory_words_count)
+        ; address < count; ++address)
+    {
+        computer->set_memory(address, mix::Word());
+    }
     for (const auto& word : program.commands)
     {
         const int address = word.translated.original_address;
@@ -22,75 +29,68 @@ static void LoadProgram(const ProgramWithSource& program, mix::Computer* compute
     computer->set_next_address(program.start_address);
 }
 
-ProgramWithSource LoadProgramFromSourceFile(
-    const std::string& file_name, mix::Computer* mix)
+static ProgramWithSource ProgramFromSession(const mixal::AssemblerSession& session)
 {
-    std::ifstream in(file_name);
-    mixal::Translator translator;
-    mixal::LinesTranslator lines_translator(translator);
-    std::vector<mixal::TranslatedLine> lines;
-    std::vector<std::string> strs;
-
-    try
-    {
-        std::string str;
-        while (getline(in, str))
-        {
-            lines.push_back(lines_translator.translate(str));
-            strs.push_back(std::move(str));
-            if (lines.back().end_code)
-            {
-                break;
-            }
-        }
-    }
-    catch (const std::exception&)
-    {
-        return ProgramWithSource();
-    }
+    const auto& commands = session.program().commands;
+    const auto& lines = session.lines();
+    const auto& strs = session.source().lines();
 
     ProgramWithSource program;
+    program.start_address = session.program().start_address;
+    program.commands.reserve(commands.size() + lines.size());
 
     for (int line_id = 0, count = static_cast<int>(lines.size()); line_id < count; ++line_id)
     {
-        auto word_ref = lines[line_id].word_ref;
-        auto end_code = lines[line_id].end_code;
-        auto id = lines[line_id].operation_id;
-        auto str = strs[line_id];
-        if (word_ref)
-        {
-            assert(word_ref->is_ready());
-            WordWithSource word;
-            word.translated = word_ref->translated_word();
-            word.line_id = line_id + 1;
-            word.operation_id = id;
-            word.line = str;
-            program.commands.push_back(word);
-        }
-        else if (end_code)
+        const auto& line = lines[line_id];
+        WordWithSource word;
+        word.line_id = line_id + 1;
+        word.operation_id = line.operation_id;
+        word.line = std::string(strs[line_id]);
+        if (line.words_count == 0)
         {
-            program.start_address = end_code->start_address;
-            for (auto& end_symbols : end_code->defined_symbols)
+            // END without generated words has no entry
+            if (line.operation_id != mixal::OperationId::END)
             {
-                WordWithSource word;
-                word.translated = end_symbols.second;
-                word.line_id = line_id + 1;
-                word.operation_id = id;
-                word.line = str;
                 program.commands.push_back(word);
             }
+            continue;
         }
-        else
+        for (std::size_t i = 0; i < line.words_count; ++i)
         {
-            WordWithSource word;
-            word.line_id = line_id + 1;
-            word.operation_id = id;
-            word.line = str;
+            word.translated = commands[line.first_word + i];
             program.commands.push_back(word);
         }
     }
+    return program;
+}
+
+ProgramWithSource LoadProgramFromSourceFile(
+    const std::string& file_name, mix::Computer* mix
+    , mixal::AssemblerSession* session, bool reload_memory)
+{
+    std::ifstream in(file_name);
+    std::ostringstream text;
+    text << in.rdbuf();
+
+    mixal::AssemblerSession::Result result;
+    try
+    {
+        result = session->assemble(text.str());
+    }
+    catch (const std::exception&)
+    {
+        return ProgramWithSource();
+    }
 
-    LoadProgram(program, mix);
+    ProgramWithSource program = ProgramFromSession(*session);
+    if (result.full_assembly || reload_memory)
+    {
+        LoadProgram(program, mix);
+    }
+    else
+    {
+        session->apply(*mix, result);
+    }
     return program;
 }
 
@@ -0,0 +1,100 @@
+#include <core/line_reader.h>
+
+#include <gtest_all.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace core;
+
+namespace {
+
+std::vector<std::string> GetLines(const std::string& text)
+{
+	std::vector<std::string> lines;
+	std::istringstream in{text};
+	std::string line;
+	while (std::getline(in, line))
+	{
+		lines.push_back(line);
+	}
+	return lines;
+}
+
+std::vector<std::string> ReadLines(LineReader& reader)
+{
+	std::vector<std::string> lines;
+	Span<char> line;
+	while (reader.next_line(line))
+	{
+		lines.emplace_back(line.data(), line.size());
+	}
+	return lines;
+}
+
+const char* const k_texts[] = {
+	"",
+	"\n",
+	"\n\n",
+	"single",
+	"single\n",
+	"a\nbb\n\nccc\r\ndddd",
+	"line that is longer than any chunk\nx\nanother long line at the end\n",
+};
+
+const std::size_t k_chunk_sizes[] = {1, 2, 3, 5, 8, 1024};
+
+} // namespace
+
+TEST(LineReader, Splits_Lines_As_Getline_For_Any_Chunk_Size)
+{
+	for (const char* text : k_texts)
+	{
+		for (std::size_t chunk_size : k_chunk_sizes)
+		{
+			for (auto lifetime : {LinesLifetime::UntilNextLine, LinesLifetime::WhileReaderIsAlive})
+			{
+				LineReader reader{ByteSource::FromMemory(text), lifetime, chunk_size};
+				const auto lines = ReadLines(reader);
+				ASSERT_EQ(GetLines(text), lines) << text << " " << chunk_size;
+				ASSERT_EQ(lines.size(), reader.lines_count());
+			}
+		}
+	}
+}
+
+TEST(LineReader, Lines_Stay_Valid_While_Reader_Is_Alive)
+{
+	const std::string text = "first line\nsecond line\nthird line\nlast";
+	LineReader reader{ByteSource::FromMemory(text), LinesLifetime::WhileReaderIsAlive, 4};
+
+	std::vector<std::string_view> views;
+	Span<char> line;
+	while (reader.next_line(line))
+	{
+		views.emplace_back(line.data(), line.size());
+	}
+
+	ASSERT_EQ((std::vector<std::string_view>{
+		"first line", "second line", "third line", "last"}), views);
+}
+
+TEST(LineReader, Reads_From_Stream)
+{
+	const std::string text = "a\nbb\nccc";
+	std::istringstream in{text};
+	LineReader reader{ByteSource::FromStream(in), LinesLifetime::UntilNextLine, 2};
+	ASSERT_EQ(GetLines(text), ReadLines(reader));
+	ASSERT_TRUE(in.eof());
+}
+
+TEST(LineReader, Line_Can_Be_Changed_In_Place)
+{
+	LineReader reader{ByteSource::FromMemory("abc\n")};
+	Span<char> line;
+	ASSERT_TRUE(reader.next_line(line));
+	line[0] = 'x';
+	ASSERT_EQ("xbc", std::string(line.data(), line.size()));
+	ASSERT_FALSE(reader.next_line(line));
+}
@@ -0,0 +1,163 @@
+#include <core/small_vector.h>
+
+#include <gtest_all.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <cstdint>
+
+using namespace core;
+
+TEST(SmallVector, Keeps_First_Elements_Inline)
+{
+	SmallVector<std::string, 2> values;
+	ASSERT_TRUE(values.empty());
+	ASSERT_EQ(2u, values.capacity());
+
+	values.push_back("first");
+	values.emplace_back("second");
+	ASSERT_TRUE(values.is_inline());
+	ASSERT_EQ(2u, values.size());
+	ASSERT_EQ("first", values.front());
+	ASSERT_EQ("second", values.back());
+
+	values.push_back("third");
+	ASSERT_FALSE(values.is_inline());
+	ASSERT_EQ(3u, values.size());
+	ASSERT_EQ("first", values[0]);
+	ASSERT_EQ("third", values[2]);
+}
+
+TEST(SmallVector, Copies_And_Moves_Inline_And_Heap_Storage)
+{
+	SmallVector<std::string, 2> small;
+	small.push_back("a");
+	SmallVector<std::string, 2> large;
+	for (int i = 0; i < 5; ++i)
+	{
+		large.push_back(std::to_string(i));
+	}
+
+	const auto small_copy = small;
+	const auto large_copy = large;
+	ASSERT_EQ(small, small_copy);
+	ASSERT_EQ(large, large_copy);
+	ASSERT_NE(small, large);
+
+	const auto* large_data = large.data();
+	auto moved_large = std::move(large);
+	ASSERT_EQ(large_data, moved_large.data());
+	ASSERT_TRUE(large.empty());
+
+	auto moved_small = std::move(small);
+	ASSERT_TRUE(moved_small.is_inline());
+	ASSERT_EQ(small_copy, moved_small);
+
+	moved_small = moved_large;
+	ASSERT_EQ(large_copy, moved_small);
+	moved_large = small_copy;
+	ASSERT_EQ(small_copy, moved_large);
+}
+
+TEST(SmallVector, Destroys_Elements)
+{
+	const auto counter = std::make_shared<int>(0);
+	{
+		SmallVector<std::shared_ptr<int>, 1> values;
+		values.push_back(counter);
+		values.push_back(counter);
+		values.push_back(counter);
+		ASSERT_EQ(4, counter.use_count());
+
+		values.pop_back();
+		ASSERT_EQ(3, counter.use_count());
+	}
+	ASSERT_EQ(1, counter.use_count());
+}
+
+TEST(SmallVector, Adds_Own_Element_When_Full)
+{
+	SmallVector<std::string, 1> values;
+	values.push_back(std::string(32, 'a'));
+	values.push_back(values[0]);
+	values.push_back(values[1]);
+	ASSERT_EQ(3u, values.size());
+	for (const auto& value : values)
+	{
+		ASSERT_EQ(std::string(32, 'a'), value);
+	}
+
+	values.emplace_back(values.back(), 1, 2);
+	ASSERT_EQ("aa", values.back());
+}
+
+namespace {
+
+struct alignas(64) OverAligned
+{
+	int value{0};
+};
+
+struct ThrowingCopy
+{
+	static int copies_left;
+
+	int value{0};
+
+	explicit ThrowingCopy(int v)
+		: value{v}
+	{
+	}
+
+	ThrowingCopy(const ThrowingCopy& other)
+		: value{other.value}
+	{
+		if (copies_left-- <= 0)
+		{
+			throw std::runtime_error{"copy"};
+		}
+	}
+
+	// Not noexcept, so elements are copied on reallocation
+	ThrowingCopy(ThrowingCopy&& other)
+		: value{other.value}
+	{
+	}
+};
+
+int ThrowingCopy::copies_left = 0;
+
+} // namespace
+
+TEST(SmallVector, Heap_Storage_Is_Aligned)
+{
+	SmallVector<OverAligned, 1> values;
+	for (int i = 0; i < 5; ++i)
+	{
+		values.push_back(OverAligned{i});
+	}
+	ASSERT_FALSE(values.is_inline());
+	ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(values.data()) % alignof(OverAligned));
+	ASSERT_EQ(4, values.back().value);
+}
+
+TEST(SmallVector, Reallocation_Error_Keeps_Elements)
+{
+	SmallVector<ThrowingCopy, 2> values;
+	values.emplace_back(1);
+	values.emplace_back(2);
+
+	ThrowingCopy::copies_left = 1;
+	ASSERT_THROW(values.reserve(10), std::runtime_error);
+	ASSERT_TRUE(values.is_inline());
+	ASSERT_EQ(2u, values.size());
+
+	ThrowingCopy::copies_left = 1;
+	ASSERT_THROW(values.emplace_back(3), std::runtime_error);
+	ASSERT_TRUE(values.is_inline());
+	ASSERT_EQ(2u, values.size());
+	ASSERT_EQ(1, values[0].value);
+	ASSERT_EQ(2, values[1].value);
+}
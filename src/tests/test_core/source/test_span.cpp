@@ -0,0 +1,36 @@
+#include <core/span.h>
+
+#include <gtest_all.h>
+
+#include <vector>
+#include <array>
+
+using namespace core;
+
+TEST(Span, Views_Container_Without_Copy)
+{
+	std::vector<int> values{1, 2, 3, 4};
+	Span<int> span{values};
+	ASSERT_EQ(values.data(), span.data());
+	ASSERT_EQ(4u, span.size());
+
+	span[0] = 10;
+	ASSERT_EQ(10, values[0]);
+
+	const Span<const int> const_span = span;
+	ASSERT_EQ(10, const_span[0]);
+
+	std::array<int, 2> array{{5, 6}};
+	ASSERT_EQ(2u, Span<const int>{array}.size());
+}
+
+TEST(Span, Subspan_Is_Clamped_To_The_End)
+{
+	int values[] = {1, 2, 3};
+	const Span<int> span{values};
+
+	ASSERT_EQ(2u, span.subspan(1).size());
+	ASSERT_EQ(1u, span.subspan(2, 10).size());
+	ASSERT_TRUE(span.subspan(3).empty());
+	ASSERT_EQ(2, *span.first(2).subspan(1).begin());
+}
@@ -0,0 +1,54 @@
+#include <core/thread_pool.h>
+
+#include <gtest_all.h>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace core;
+
+TEST(ThreadPool, Runs_All_Submitted_Tasks)
+{
+	ThreadPool pool{4};
+	ASSERT_EQ(4u, pool.threads_count());
+
+	std::atomic<int> sum{0};
+	for (int i = 1; i <= 1000; ++i)
+	{
+		pool.submit([&sum, i] { sum += i; });
+	}
+	pool.wait();
+
+	ASSERT_EQ(500500, sum.load());
+}
+
+TEST(ThreadPool, Runs_Tasks_Submitted_From_Other_Tasks)
+{
+	ThreadPool pool{2};
+
+	std::atomic<int> count{0};
+	for (int i = 0; i < 10; ++i)
+	{
+		pool.submit([&pool, &count]
+		{
+			for (int j = 0; j < 10; ++j)
+			{
+				pool.submit([&count] { ++count; });
+			}
+		});
+	}
+	pool.wait();
+
+	ASSERT_EQ(100, count.load());
+}
+
+TEST(ThreadPool, Wait_Rethrows_Task_Exception)
+{
+	ThreadPool pool{2};
+	pool.submit([] { throw std::runtime_error("task error"); });
+	pool.submit([] {});
+
+	ASSERT_THROW(pool.wait(), std::runtime_error);
+	// Exception is reported once
+	pool.wait();
+}
@@ -0,0 +1,122 @@
+#include "precompiled.h"
+
+#include <mix/file_device.h>
+#include <mix/char_table.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <cstdio>
+
+using namespace mix;
+
+namespace {
+
+class FileReaderDeviceTest :
+	public ::testing::Test
+{
+protected:
+	void TearDown() override
+	{
+		std::remove(file_path_.c_str());
+	}
+
+	const std::string& write_file(const std::string& content)
+	{
+		std::ofstream file{file_path_, std::ios_base::binary};
+		file << content;
+		return file_path_;
+	}
+
+	static std::string BlockToText(const IIODevice::Block& block)
+	{
+		std::string text;
+		for (const auto& word : block)
+		{
+			for (auto byte : word.bytes())
+			{
+				text += ByteToChar(byte);
+			}
+		}
+		return text;
+	}
+
+	static IIODevice::Block ReadWhenReady(IIODevice& device)
+	{
+		while (!device.ready())
+		{
+		}
+		return device.read(0);
+	}
+
+private:
+	const std::string file_path_ = ::testing::TempDir() + "mix_file_device_test.txt";
+};
+
+} // namespace
+
+TEST_F(FileReaderDeviceTest, Reads_File_Line_By_Line)
+{
+	FileReaderDevice device{2, write_file("FIRST LINE\r\nSHORT\n\nTOO LONG LINE\n")};
+	ASSERT_EQ(2, device.block_size());
+
+	ASSERT_EQ("FIRST LINE", BlockToText(ReadWhenReady(device)));
+	ASSERT_EQ("SHORT     ", BlockToText(ReadWhenReady(device)));
+	ASSERT_EQ("          ", BlockToText(ReadWhenReady(device)));
+	ASSERT_EQ("TOO LONG L", BlockToText(ReadWhenReady(device)));
+	ASSERT_EQ("INE       ", BlockToText(ReadWhenReady(device)));
+	// Past the end of file
+	ASSERT_EQ("          ", BlockToText(ReadWhenReady(device)));
+}
+
+TEST_F(FileReaderDeviceTest, Reads_More_Records_Than_Read_Ahead_Queue_Holds)
+{
+	std::string content;
+	for (int i = 0; i < 1000; ++i)
+	{
+		content += std::to_string(10000 + i) + "\n";
+	}
+
+	FileReaderDevice device{1, write_file(content), 4/*read-ahead blocks*/};
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(std::to_string(10000 + i),
+			BlockToText(ReadWhenReady(device)));
+	}
+}
+
+TEST_F(FileReaderDeviceTest, Card_Reader_Is_Used_By_IN_Command)
+{
+	Computer mix;
+	mix.replace_device(16, MakeCardReaderDevice(write_file("CARD1\nCARD2\n")));
+
+	mix.execute(MakeIN(1000, 16));
+	mix.execute(MakeIN(1100, 16));
+
+	ASSERT_EQ(CharToByte('1'), mix.memory(1000).byte(5));
+	ASSERT_EQ(CharToByte('2'), mix.memory(1100).byte(5));
+	ASSERT_EQ(CharToByte(' '), mix.memory(1015).byte(5));
+}
+
+TEST_F(FileReaderDeviceTest, Read_Error_Is_Thrown_From_Read)
+{
+	std::unique_ptr<IIODevice> device;
+	try
+	{
+		// Directory is opened as file on POSIX systems, but can't be read
+		device = MakeCardReaderDevice(::testing::TempDir());
+	}
+	catch (const DeviceFileOpenError&)
+	{
+		GTEST_SKIP();
+	}
+
+	ASSERT_THROW(ReadWhenReady(*device), DeviceFileReadError);
+	// Device stays broken
+	ASSERT_THROW(device->read(0), DeviceFileReadError);
+}
+
+TEST(FileReaderDevice, Throws_When_File_Can_Not_Be_Opened)
+{
+	ASSERT_THROW(MakePaperTapeReaderDevice("not/existing/file.txt"), DeviceFileOpenError);
+}
@@ -0,0 +1,122 @@
+#include "precompiled.h"
+
+#include <mix/default_device.h>
+
+#include <sstream>
+
+using namespace mix;
+
+TEST(ComputerSnapshot, Restores_Registers_And_Flags)
+{
+	Computer mix;
+	mix.set_ra(Register(42));
+	mix.set_rx(Register(-7));
+	mix.set_ri(3, IndexRegister(100));
+	mix.set_overflow_flag(OverflowFlag::Overflow);
+	mix.set_comparison_state(ComparisonIndicator::Greater);
+
+	const ComputerSnapshot snapshot = mix.snapshot();
+	ASSERT_FALSE(snapshot.empty());
+
+	mix.set_ra(Register(1));
+	mix.set_rx(Register(2));
+	mix.set_ri(3, IndexRegister(3));
+	mix.set_overflow_flag(OverflowFlag::NoOverflow);
+	mix.set_comparison_state(ComparisonIndicator::Equal);
+
+	mix.restore(snapshot);
+
+	ASSERT_EQ(Register(42), mix.ra());
+	ASSERT_EQ(Register(-7), mix.rx());
+	ASSERT_EQ(IndexRegister(100), mix.ri(3));
+	ASSERT_EQ(OverflowFlag::Overflow, mix.overflow_flag());
+	ASSERT_EQ(ComparisonIndicator::Greater, mix.comparison_state());
+}
+
+TEST(ComputerSnapshot, Restores_Memory_Any_Number_Of_Times)
+{
+	Computer mix;
+	mix.set_memory(0, Word(1));
+	mix.set_memory(3999, Word(2));
+
+	const ComputerSnapshot snapshot = mix.snapshot();
+
+	for (int i = 0; i < 3; ++i)
+	{
+		mix.set_memory(0, Word(10 + i));
+		mix.set_memory(1000, Word(20 + i));
+		mix.set_memory(3999, Word(30 + i));
+
+		mix.restore(snapshot);
+
+		ASSERT_EQ(Word(1), mix.memory(0));
+		ASSERT_EQ(Word(0), mix.memory(1000));
+		ASSERT_EQ(Word(2), mix.memory(3999));
+	}
+}
+
+TEST(ComputerSnapshot, Switches_Between_Different_Snapshots)
+{
+	Computer mix;
+	mix.set_memory(500, Word(1));
+	const ComputerSnapshot first = mix.snapshot();
+
+	mix.set_memory(500, Word(2));
+	mix.set_memory(2500, Word(3));
+	const ComputerSnapshot second = mix.snapshot();
+
+	mix.restore(first);
+	ASSERT_EQ(Word(1), mix.memory(500));
+	ASSERT_EQ(Word(0), mix.memory(2500));
+
+	mix.restore(second);
+	ASSERT_EQ(Word(2), mix.memory(500));
+	ASSERT_EQ(Word(3), mix.memory(2500));
+}
+
+TEST(ComputerSnapshot, Rewinds_Input_Device)
+{
+	const DeviceId k_device_id = 16;
+
+	Computer mix;
+	mix.replace_device(k_device_id, std::make_unique<SymbolDevice>(1,
+		std::make_unique<std::ostringstream>(),
+		std::make_unique<std::istringstream>("ABCDE")));
+
+	const ComputerSnapshot snapshot = mix.snapshot();
+
+	mix.execute(MakeIN(1000, k_device_id));
+	const Word first_read = mix.memory(1000);
+
+	mix.restore(snapshot);
+	ASSERT_EQ(Word(0), mix.memory(1000));
+
+	mix.execute(MakeIN(1000, k_device_id));
+	ASSERT_EQ(first_read, mix.memory(1000));
+}
+
+TEST(ComputerSnapshot, Does_Not_Rewind_Not_Owned_Streams)
+{
+	const DeviceId k_device_id = 16;
+
+	std::istringstream in("ABCDEFGHIJ");
+	std::ostringstream out;
+
+	Computer mix;
+	mix.replace_device(k_device_id, std::make_unique<SymbolDevice>(1, out, in));
+
+	const ComputerSnapshot snapshot = mix.snapshot();
+
+	mix.execute(MakeIN(1000, k_device_id));
+	const Word first_read = mix.memory(1000);
+
+	mix.restore(snapshot);
+	mix.execute(MakeIN(1000, k_device_id));
+	ASSERT_NE(first_read, mix.memory(1000));
+}
+
+TEST(ComputerSnapshot, Throws_On_Empty_Snapshot_Restore)
+{
+	Computer mix;
+	ASSERT_THROW(mix.restore(ComputerSnapshot{}), std::logic_error);
+}
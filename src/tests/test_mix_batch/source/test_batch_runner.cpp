@@ -0,0 +1,175 @@
+#include <mix_batch/batch_runner.h>
+
+#include <mixal/program_executor.h>
+
+#include <gtest_all.h>
+
+#include <sstream>
+
+using namespace mix_batch;
+
+namespace {
+
+mixal::TranslatedProgram Translate(const char* code)
+{
+	std::istringstream in{code};
+	return mixal::TranslateProgram(in);
+}
+
+// Copies first card (16 words) from PunchCard to Perforator
+const char k_echo_program[] =
+	" ORIG 100\n"
+	"START IN 1000(16)\n"
+	" OUT 1000(17)\n"
+	" HLT\n"
+	" END START\n";
+
+// Takes the other path when run second time on the same memory
+const char k_run_once_program[] =
+	" ORIG 100\n"
+	"START LDA FLAG\n"
+	" JANZ AGAIN\n"
+	" ENTA 1\n"
+	" STA FLAG\n"
+	" IN 1000(16)\n"
+	" OUT 1000(17)\n"
+	" HLT\n"
+	"AGAIN HLT\n"
+	"FLAG CON 0\n"
+	" END START\n";
+
+const char k_endless_program[] =
+	"START NOP\n"
+	" JMP START\n"
+	" END START\n";
+
+const char k_bad_address_program[] =
+	"START ENT1 100\n"
+	" LDA 3950,1\n"
+	" HLT\n"
+	" END START\n";
+
+} // namespace
+
+TEST(BatchRunner, Binds_Devices_To_Task_Input_And_Output)
+{
+	const auto program = Translate(k_echo_program);
+
+	BatchTask task;
+	task.name = "echo";
+	task.input = "ECHO";
+
+	const auto result = RunTask(program, task);
+	ASSERT_EQ(ExitReason::Halted, result.exit_reason);
+	ASSERT_EQ(3, result.commands_count);
+	ASSERT_EQ(0u, result.output.find("ECHO"));
+	ASSERT_TRUE(result.error.empty());
+}
+
+TEST(BatchRunner, Reads_Input_The_Same_Way_As_Default_Devices)
+{
+	const auto program = Translate(k_echo_program);
+
+	BatchTask task;
+	// White space and line breaks are skipped
+	task.input = "AB CD\nEF\n  GHIJ";
+	const auto result = RunTask(program, task);
+
+	std::istringstream in{task.input};
+	std::ostringstream out;
+	mix::Computer computer;
+	computer.bind_devices(out, in);
+	mixal::LoadProgram(computer, program);
+	computer.run();
+
+	ASSERT_EQ(ExitReason::Halted, result.exit_reason);
+	ASSERT_EQ(out.str(), result.output);
+	ASSERT_EQ(0u, result.output.find("ABCD EFGH IJ"));
+}
+
+TEST(BatchRunner, Every_Task_Starts_From_Loaded_Program)
+{
+	const auto program = Translate(k_run_once_program);
+
+	std::vector<BatchTask> tasks(3);
+	tasks[0].input = "ONE";
+	// Stops in the middle, before device is read
+	tasks[1].input = "SKIP";
+	tasks[1].commands_budget = 4;
+	tasks[2].input = "TWO";
+
+	BatchOptions options;
+	options.threads_count = 1;
+	const auto report = RunBatch(program, tasks, options);
+
+	ASSERT_EQ(ExitReason::Halted, report.results[0].exit_reason);
+	ASSERT_EQ(7, report.results[0].commands_count);
+	ASSERT_EQ(0u, report.results[0].output.find("ONE"));
+
+	ASSERT_EQ(ExitReason::BudgetExhausted, report.results[1].exit_reason);
+	ASSERT_TRUE(report.results[1].output.empty());
+
+	ASSERT_EQ(ExitReason::Halted, report.results[2].exit_reason);
+	ASSERT_EQ(7, report.results[2].commands_count);
+	ASSERT_EQ(0u, report.results[2].output.find("TWO"));
+	ASSERT_EQ(RunTask(program, tasks[2]).output, report.results[2].output);
+}
+
+TEST(BatchRunner, Stops_Task_When_Budget_Is_Exhausted)
+{
+	const auto program = Translate(k_endless_program);
+
+	BatchTask task;
+	task.commands_budget = 1000;
+
+	const auto result = RunTask(program, task);
+	ASSERT_EQ(ExitReason::BudgetExhausted, result.exit_reason);
+	ASSERT_EQ(1000, result.commands_count);
+}
+
+TEST(BatchRunner, Reports_Computer_Errors)
+{
+	const auto program = Translate(k_bad_address_program);
+
+	const auto result = RunTask(program, BatchTask{});
+	ASSERT_EQ(ExitReason::Error, result.exit_reason);
+	ASSERT_EQ(1, result.commands_count);
+	ASSERT_FALSE(result.error.empty());
+}
+
+TEST(BatchRunner, Reports_Program_Without_Start_Address_As_Error)
+{
+	const auto result = RunTask(mixal::TranslatedProgram{}, BatchTask{});
+	ASSERT_EQ(ExitReason::Error, result.exit_reason);
+}
+
+TEST(BatchRunner, Runs_All_Tasks_And_Keeps_Their_Order)
+{
+	const auto program = Translate(k_echo_program);
+
+	std::vector<BatchTask> tasks;
+	for (int i = 0; i < 50; ++i)
+	{
+		BatchTask task;
+		task.name = std::to_string(i);
+		task.input = "IN" + std::to_string(i);
+		tasks.push_back(std::move(task));
+	}
+
+	BatchOptions options;
+	options.threads_count = 4;
+	const auto report = RunBatch(program, tasks, options);
+
+	ASSERT_EQ(tasks.size(), report.results.size());
+	ASSERT_EQ(tasks.size(), report.halted_count);
+	ASSERT_EQ(0u, report.budget_exhausted_count);
+	ASSERT_EQ(0u, report.errors_count);
+	ASSERT_EQ(static_cast<long long>(3 * tasks.size()), report.total_commands_count);
+
+	for (std::size_t i = 0; i < tasks.size(); ++i)
+	{
+		const auto& result = report.results[i];
+		ASSERT_EQ(tasks[i].name, result.name);
+		ASSERT_EQ(0u, result.output.find(tasks[i].input));
+	}
+}
@@ -0,0 +1,185 @@
+#include <mixal/assembler_session.h>
+#include <mixal/program_executor.h>
+
+#include <mix/computer.h>
+#include <mix/command.h>
+
+#include <gtest_all.h>
+
+#include <sstream>
+#include <string>
+
+#include <cassert>
+
+using namespace mixal;
+
+namespace {
+
+const char k_program[] =
+	"* COUNTS DOWN FROM 5\n"
+	"N EQU 5\n"
+	" ORIG 1000\n"
+	"START ENTA N\n"
+	"LOOP DECA 1\n"
+	" JAP LOOP\n"
+	" STA RESULT\n"
+	" HLT\n"
+	"RESULT CON 0\n"
+	" END START\n";
+
+std::string Replace(std::string text, const std::string& from, const std::string& to)
+{
+	const auto pos = text.find(from);
+	assert(pos != std::string::npos);
+	return text.replace(pos, from.size(), to);
+}
+
+void AssertSameAsFullTranslation(const AssemblerSession& session, const std::string& text)
+{
+	std::istringstream in{text};
+	const auto expected = TranslateProgram(in);
+	const auto& actual = session.program();
+	ASSERT_EQ(expected.start_address, actual.start_address);
+	ASSERT_EQ(expected.commands.size(), actual.commands.size());
+	for (std::size_t i = 0; i < expected.commands.size(); ++i)
+	{
+		ASSERT_EQ(expected.commands[i].original_address, actual.commands[i].original_address);
+		ASSERT_EQ(expected.commands[i].value, actual.commands[i].value);
+	}
+}
+
+} // namespace
+
+TEST(AssemblerSessionTest, First_Assembly_Is_Full)
+{
+	AssemblerSession session;
+	const auto result = session.assemble(k_program);
+	ASSERT_TRUE(result.full_assembly);
+	AssertSameAsFullTranslation(session, k_program);
+
+	const auto& lines = session.lines();
+	ASSERT_EQ(10u, lines.size());
+	ASSERT_EQ(0u, lines[0].words_count);
+	ASSERT_EQ(1u, lines[3].words_count);
+	ASSERT_EQ(0u, lines[3].first_word);
+	ASSERT_EQ(OperationId::ENTA, lines[3].operation_id);
+}
+
+TEST(AssemblerSessionTest, Changed_Commands_Are_Patched)
+{
+	AssemblerSession session;
+	session.assemble(k_program);
+
+	const std::string edited = Replace(
+		Replace(k_program, "LOOP DECA 1", "LOOP DECA 2"),
+		" STA RESULT", " STX RESULT(1:5)");
+	const auto result = session.assemble(edited);
+
+	ASSERT_FALSE(result.full_assembly);
+	ASSERT_EQ(2u, result.patched_words.size());
+	ASSERT_EQ(1001, result.patched_words[0].original_address);
+	ASSERT_EQ(1003, result.patched_words[1].original_address);
+	ASSERT_EQ(OperationId::STX, session.lines()[6].operation_id);
+	AssertSameAsFullTranslation(session, edited);
+}
+
+TEST(AssemblerSessionTest, Unchanged_Source_Has_No_Patches)
+{
+	AssemblerSession session;
+	session.assemble(k_program);
+	const auto result = session.assemble(k_program);
+	ASSERT_FALSE(result.full_assembly);
+	ASSERT_TRUE(result.patched_words.empty());
+}
+
+TEST(AssemblerSessionTest, Many_Edits_Refer_Only_To_Current_Source)
+{
+	AssemblerSession session;
+	session.assemble(k_program);
+
+	std::string edited = k_program;
+	for (int i = 1; i <= 3; ++i)
+	{
+		edited = Replace(k_program, "LOOP DECA 1", "LOOP DECA " + std::to_string(i + 1));
+		ASSERT_FALSE(session.assemble(edited).full_assembly);
+		ASSERT_EQ(edited, session.source().text());
+	}
+
+	// Symbols are still known after previous sources are gone
+	edited = Replace(edited, " JAP LOOP", " JAN LOOP");
+	ASSERT_FALSE(session.assemble(edited).full_assembly);
+	AssertSameAsFullTranslation(session, edited);
+}
+
+TEST(AssemblerSessionTest, Layout_Changes_Require_Full_Assembly)
+{
+	const std::string edits[] = {
+		Replace(k_program, "N EQU 5", "N EQU 6"),
+		Replace(k_program, " ORIG 1000", " ORIG 2000"),
+		Replace(k_program, " END START", " END LOOP"),
+		Replace(k_program, " HLT\n", " HLT\n NOP\n"),
+		Replace(k_program, "LOOP DECA 1", "AGAIN DECA 1\nLOOP NOP"),
+		Replace(k_program, " STA RESULT", " STA =1="),
+		Replace(k_program, " STA RESULT", " STA UNDEFINED"),
+		Replace(k_program, " HLT", "* HLT"),
+	};
+
+	for (const auto& edited : edits)
+	{
+		AssemblerSession session;
+		session.assemble(k_program);
+		ASSERT_TRUE(session.assemble(edited).full_assembly) << edited;
+		AssertSameAsFullTranslation(session, edited);
+	}
+}
+
+TEST(AssemblerSessionTest, Applies_Patches_To_Memory)
+{
+	AssemblerSession session;
+	mix::Computer computer;
+	session.apply(computer, session.assemble(k_program));
+	computer.set_next_address(0);
+
+	const auto result = session.assemble(Replace(k_program, "LOOP DECA 1", "LOOP DECA 2"));
+	ASSERT_FALSE(result.full_assembly);
+	session.apply(computer, result);
+	ASSERT_EQ(1000, computer.current_address());
+	computer.run();
+	ASSERT_EQ(-1, computer.memory(1005).value());
+}
+
+TEST(AssemblerSessionTest, Patched_Memory_Is_The_Same_As_After_Full_Load)
+{
+	AssemblerSession session;
+	mix::Computer computer;
+	session.apply(computer, session.assemble(k_program));
+
+	const auto edited = Replace(k_program, "LOOP DECA 1", "LOOP DECA 2");
+	const auto result = session.assemble(edited);
+	ASSERT_FALSE(result.full_assembly);
+	// Reload with fresh registers, but with memory of previous load
+	mix::Computer reloaded;
+	for (int address = 0; address < static_cast<int>(mix::Computer::k_memory_words_count); ++address)
+	{
+		reloaded.set_memory(address, computer.memory(address));
+	}
+	session.apply(reloaded, result);
+
+	std::istringstream in{edited};
+	mix::Computer expected;
+	LoadProgram(expected, TranslateProgram(in));
+	ASSERT_EQ(expected.current_address(), reloaded.current_address());
+	for (int address = 0; address < static_cast<int>(mix::Computer::k_memory_words_count); ++address)
+	{
+		ASSERT_EQ(expected.memory(address), reloaded.memory(address)) << address;
+	}
+}
+
+TEST(AssemblerSessionTest, Error_Resets_Session)
+{
+	AssemblerSession session;
+	session.assemble(k_program);
+	ASSERT_ANY_THROW(session.assemble(Replace(k_program, "LOOP DECA 1", "LOOP DECA 1,,,")));
+	ASSERT_TRUE(session.lines().empty());
+	ASSERT_TRUE(session.assemble(k_program).full_assembly);
+}
@@ -0,0 +1,149 @@
+#include <mixal/diagnostics.h>
+#include <mixal/program_executor.h>
+
+#include <mix/command.h>
+
+#include <gtest_all.h>
+
+#include <string>
+
+using namespace mixal;
+
+namespace {
+
+const char k_valid_program[] =
+	" ORIG 1000\n"
+	"START LDA X\n"
+	" JMP NEXT\n"
+	"NEXT STA Y\n"
+	" HLT\n"
+	"X CON 5\n"
+	"Y CON 0\n"
+	" END START\n";
+
+} // namespace
+
+TEST(DiagnosticsTest, Valid_Program_Has_No_Diagnostics)
+{
+	const SourceBuffer source{k_valid_program};
+	Diagnostics diagnostics;
+	const auto program = TranslateProgram(source, diagnostics);
+	ASSERT_TRUE(diagnostics.empty());
+
+	const auto expected = TranslateProgram(source);
+	ASSERT_EQ(expected.start_address, program.start_address);
+	ASSERT_EQ(expected.commands.size(), program.commands.size());
+	for (std::size_t i = 0; i < expected.commands.size(); ++i)
+	{
+		ASSERT_EQ(expected.commands[i].original_address, program.commands[i].original_address);
+		ASSERT_EQ(expected.commands[i].value, program.commands[i].value);
+	}
+}
+
+TEST(DiagnosticsTest, All_Errors_Are_Reported_In_One_Pass)
+{
+	const SourceBuffer source{
+		" ORIG 1000\n"
+		"START LDA 2(\n"
+		"X EQU 1/0\n"
+		"LOOP CON 1\n"
+		"LOOP CON 2\n"
+		" LDA 5B\n"
+		" JMP START\n"
+		" END START\n"};
+	Diagnostics diagnostics;
+	const auto program = TranslateProgram(source, diagnostics);
+
+	const auto& all = diagnostics.all();
+	ASSERT_EQ(4u, all.size());
+
+	ASSERT_EQ(2u, all[0].line);
+	ASSERT_EQ(1u, all[0].column);
+	ASSERT_EQ("parse error", all[0].message);
+
+	ASSERT_EQ(3u, all[1].line);
+	ASSERT_EQ("division by zero", all[1].message);
+
+	ASSERT_EQ(5u, all[2].line);
+	ASSERT_EQ(1u, all[2].column);
+	ASSERT_EQ("LOOP", all[2].symbol);
+	ASSERT_EQ("duplicate symbol definition", all[2].message);
+
+	ASSERT_EQ(6u, all[3].line);
+	ASSERT_EQ(6u, all[3].column);
+	ASSERT_EQ("5B", all[3].symbol);
+	ASSERT_EQ("6:6: error: invalid local symbol reference `5B`", ToString(all[3]));
+
+	// Placeholders keep addresses of the next lines
+	ASSERT_EQ(1000, program.start_address);
+	ASSERT_EQ(5u, program.commands.size());
+	ASSERT_EQ(1000, program.commands[0].original_address);
+	ASSERT_EQ(Word{}, program.commands[0].value);
+	ASSERT_EQ(1004, program.commands[4].original_address);
+	ASSERT_EQ(1000, mix::Command{program.commands[4].value}.address());
+}
+
+TEST(DiagnosticsTest, Errors_Found_On_END_Are_Reported_For_Lines_That_Refer_To_Symbols)
+{
+	const SourceBuffer source{
+		" ORIG 100\n"
+		"START LDA =UNDEF=\n"
+		" LDX =1/Z=\n"
+		" LDA X*X\n"
+		" LDA 1F\n"
+		" HLT\n"
+		"Z EQU 0\n"
+		"X EQU 1000\n"
+		" END START\n"};
+	Diagnostics diagnostics;
+	TranslateProgram(source, diagnostics);
+
+	const auto& all = diagnostics.all();
+	ASSERT_EQ(4u, all.size());
+	ASSERT_EQ("2:12: error: undefined symbol `UNDEF`", ToString(all[0]));
+	ASSERT_EQ(3u, all[1].line);
+	ASSERT_EQ("division by zero", all[1].message);
+	// Found when `X` is defined
+	ASSERT_EQ(4u, all[2].line);
+	ASSERT_EQ("5:6: error: invalid local symbol reference `1F`", ToString(all[3]));
+}
+
+TEST(DiagnosticsTest, Errors_Found_Later_Belong_To_Word_Even_If_Its_Address_Is_Reused)
+{
+	const SourceBuffer source{
+		" ORIG 100\n"
+		"START LDA X*X\n"
+		" ORIG 100\n"
+		" NOP\n"
+		" ORIG 200\n"
+		" LDA =1/Z=\n"
+		" ORIG 200\n"
+		" HLT\n"
+		"Z EQU 0\n"
+		"X EQU 1000\n"
+		" END START\n"};
+	Diagnostics diagnostics;
+	TranslateProgram(source, diagnostics);
+
+	const auto& all = diagnostics.all();
+	ASSERT_EQ(2u, all.size());
+	ASSERT_EQ(2u, all[0].line);
+	ASSERT_EQ(6u, all[1].line);
+	ASSERT_EQ("division by zero", all[1].message);
+}
+
+TEST(DiagnosticsTest, Missing_END_Is_Reported)
+{
+	const SourceBuffer source{
+		" ORIG 100\n"
+		" LDA X\n"
+		" HLT\n"};
+	Diagnostics diagnostics;
+	const auto program = TranslateProgram(source, diagnostics);
+
+	ASSERT_EQ(1u, diagnostics.size());
+	ASSERT_EQ("3:0: error: missing END", ToString(diagnostics.all()[0]));
+	// Word that waits for `X` is not ready
+	ASSERT_EQ(1u, program.commands.size());
+	ASSERT_EQ(101, program.commands[0].original_address);
+}
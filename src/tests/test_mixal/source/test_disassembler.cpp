@@ -0,0 +1,199 @@
+#include <mixal/disassembler.h>
+#include <mixal/mdk_program_loader.h>
+#include <mixal/program_executor.h>
+#include <mixal/exceptions.h>
+
+#include <gtest_all.h>
+
+#include <algorithm>
+#include <sstream>
+#include <map>
+
+using namespace mixal;
+
+namespace {
+
+const char* const k_source =
+	"TERM     EQU  19\n"
+	"         ORIG 100\n"
+	"START    LDA  COUNT\n"
+	"LOOP     JAZ  DONE\n"
+	"         DECA 1\n"
+	"         STA  COUNT(1:5)\n"
+	"         ADD  COUNT(1:3)\n"
+	"         JMP  LOOP\n"
+	"DONE     OUT  TEXT(TERM)\n"
+	"         LDX  -0\n"
+	"         JMP  0,1\n"
+	"         HLT\n"
+	"COUNT    CON  -5\n"
+	"         CON  -0\n"
+	"TEXT     ALF  \"HELLO\"\n"
+	"         ORIG 2000\n"
+	"         CON  1000000\n"
+	"         END  START\n";
+
+std::map<int, Word> Memory(const TranslatedProgram& program)
+{
+	std::map<int, Word> memory;
+	for (const auto& word : program.commands)
+	{
+		memory[word.original_address] = word.value;
+	}
+	return memory;
+}
+
+void AssertSameMemory(const TranslatedProgram& expected, const TranslatedProgram& actual)
+{
+	ASSERT_EQ(expected.start_address, actual.start_address);
+	const auto lhs = Memory(expected);
+	const auto rhs = Memory(actual);
+	ASSERT_EQ(lhs.size(), rhs.size());
+	for (const auto& word : lhs)
+	{
+		const auto it = rhs.find(word.first);
+		ASSERT_NE(it, rhs.end()) << word.first;
+		ASSERT_EQ(word.second, it->second) << word.first;
+		ASSERT_EQ(word.second.sign(), it->second.sign()) << word.first;
+	}
+}
+
+std::string ToSource(const DisassembledProgram& program)
+{
+	std::ostringstream out;
+	WriteDisassembledProgram(out, program);
+	return out.str();
+}
+
+const DisassembledWord& WordAt(const DisassembledProgram& program, int address)
+{
+	const auto it = std::find_if(program.words.cbegin(), program.words.cend(),
+		[address](const DisassembledWord& word)
+	{
+		return (word.address == address);
+	});
+	EXPECT_NE(it, program.words.cend());
+	return *it;
+}
+
+} // namespace
+
+TEST(DisassemblerTest, Disassembled_Program_Is_Translated_To_The_Same_Words)
+{
+	const auto program = TranslateProgram(SourceBuffer{k_source});
+	const auto disassembled = Disassemble(program);
+	const auto source = ToSource(disassembled);
+
+	AssertSameMemory(program, TranslateProgram(SourceBuffer{source}));
+	ASSERT_EQ(10u, disassembled.code_words_count);
+	ASSERT_EQ(4u, disassembled.data_words_count);
+}
+
+TEST(DisassemblerTest, Code_Is_Separated_From_Data)
+{
+	const auto disassembled = Disassemble(TranslateProgram(SourceBuffer{k_source}));
+
+	ASSERT_TRUE(WordAt(disassembled, 100).is_code);
+	ASSERT_TRUE(WordAt(disassembled, 109).is_code);
+	ASSERT_EQ(OperationId::HLT, WordAt(disassembled, 109).id);
+
+	ASSERT_FALSE(WordAt(disassembled, 110).is_code);
+	ASSERT_EQ(OperationId::CON, WordAt(disassembled, 110).id);
+	ASSERT_EQ("-5", WordAt(disassembled, 110).operand);
+	ASSERT_EQ("-0", WordAt(disassembled, 111).operand);
+	ASSERT_EQ(OperationId::ALF, WordAt(disassembled, 112).id);
+	ASSERT_EQ("\"HELLO\"", WordAt(disassembled, 112).operand);
+	ASSERT_EQ(OperationId::CON, WordAt(disassembled, 2000).id);
+}
+
+TEST(DisassemblerTest, Labels_Are_Synthesized_For_Referenced_Addresses)
+{
+	const auto disassembled = Disassemble(TranslateProgram(SourceBuffer{k_source}));
+
+	ASSERT_EQ("START", disassembled.start_operand);
+	ASSERT_EQ("START", WordAt(disassembled, 100).label);
+	ASSERT_EQ("L0101", WordAt(disassembled, 101).label);
+	ASSERT_EQ("L0106", WordAt(disassembled, 106).label);
+	ASSERT_EQ("D0110", WordAt(disassembled, 110).label);
+	ASSERT_TRUE(WordAt(disassembled, 102).label.empty());
+
+	ASSERT_EQ("D0110", WordAt(disassembled, 100).operand);
+	ASSERT_EQ("L0106", WordAt(disassembled, 101).operand);
+	ASSERT_EQ("1", WordAt(disassembled, 102).operand);
+	ASSERT_EQ("D0110(1:3)", WordAt(disassembled, 104).operand);
+	ASSERT_EQ("D0112(19)", WordAt(disassembled, 106).operand);
+	ASSERT_EQ("0,1", WordAt(disassembled, 108).operand);
+}
+
+TEST(DisassemblerTest, Names_Of_Debug_Symbols_Are_Used_For_Labels)
+{
+	const SymbolsNames symbols = {
+		{"TERM", 19},
+		{"2H", 101},
+		{"LOOP", 101},
+		{"DONE", 106},
+		{"L0110", 106},
+		{"COUNT", 110}};
+	const auto program = TranslateProgram(SourceBuffer{k_source});
+	const auto disassembled = Disassemble(program, symbols);
+
+	ASSERT_EQ("LOOP", WordAt(disassembled, 101).label);
+	ASSERT_EQ("DONE", WordAt(disassembled, 106).label);
+	ASSERT_EQ("COUNT", WordAt(disassembled, 110).label);
+	ASSERT_EQ("COUNT(1:5)", WordAt(disassembled, 103).operand);
+	AssertSameMemory(program, TranslateProgram(SourceBuffer{ToSource(disassembled)}));
+}
+
+TEST(DisassemblerTest, Control_Flow_Graph_Follows_Jumps)
+{
+	const auto graph = BuildControlFlowGraph(TranslateProgram(SourceBuffer{k_source}));
+
+	ASSERT_EQ(100, graph.entry_address);
+	ASSERT_EQ(5u, graph.blocks.size());
+
+	ASSERT_EQ(100, graph.blocks[0].begin_address);
+	ASSERT_EQ(101, graph.blocks[0].end_address);
+	ASSERT_EQ((std::vector<int>{101}), graph.blocks[0].successors);
+
+	// LOOP: JAZ DONE
+	ASSERT_EQ(101, graph.blocks[1].begin_address);
+	ASSERT_EQ(102, graph.blocks[1].end_address);
+	ASSERT_EQ((std::vector<int>{102, 106}), graph.blocks[1].successors);
+
+	// JMP LOOP is treated as call
+	ASSERT_EQ(102, graph.blocks[2].begin_address);
+	ASSERT_EQ(106, graph.blocks[2].end_address);
+	ASSERT_EQ((std::vector<int>{101, 106}), graph.blocks[2].successors);
+
+	// JMP 0,1 has unknown target
+	ASSERT_EQ(106, graph.blocks[3].begin_address);
+	ASSERT_EQ(109, graph.blocks[3].end_address);
+	ASSERT_EQ((std::vector<int>{109}), graph.blocks[3].successors);
+	ASSERT_TRUE(graph.blocks[3].has_unknown_successor);
+
+	// HLT ends the program
+	ASSERT_EQ(109, graph.blocks[4].begin_address);
+	ASSERT_EQ(110, graph.blocks[4].end_address);
+	ASSERT_TRUE(graph.blocks[4].successors.empty());
+	ASSERT_FALSE(graph.blocks[4].has_unknown_successor);
+}
+
+TEST(DisassemblerTest, MDK_Code_File_Is_Disassembled_And_Translated_Back)
+{
+	MDKProgram mdk_program;
+	mdk_program.program = TranslateProgram(SourceBuffer{k_source});
+	std::ostringstream out;
+	WriteMDKProgram(out, mdk_program);
+
+	const auto parsed = ParseMDKProgram(out.str());
+	const auto source = ToSource(Disassemble(parsed.program, parsed.symbols));
+	AssertSameMemory(mdk_program.program, TranslateProgram(SourceBuffer{source}));
+}
+
+TEST(DisassemblerTest, Words_Outside_Of_Memory_Are_Not_Disassembled)
+{
+	TranslatedProgram program;
+	program.start_address = 0;
+	program.commands.push_back({4000, Word(1)});
+	ASSERT_THROW(Disassemble(program), DisassembleError);
+}
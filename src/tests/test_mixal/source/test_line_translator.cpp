@@ -100,3 +100,125 @@ TEST_F(LineTranslatorTest, TODO_Name_This_Case)
 	ASSERT_EQ(3009, Command{word1->value}.address());
 }
 
+
+TEST_F(LineTranslatorTest, Defining_Symbol_Resolves_Only_Words_That_Wait_For_It)
+{
+	auto word1 = translate(" JMP X");
+	auto word2 = translate(" LDA Y");
+	auto word3 = translate(" STA X+X");
+
+	translate("X NOP");
+
+	ASSERT_TRUE(word1->is_ready());
+	ASSERT_EQ(3, Command{word1->value}.address());
+	ASSERT_FALSE(word2->is_ready());
+	ASSERT_TRUE(word3->is_ready());
+	ASSERT_EQ(6, Command{word3->value}.address());
+
+	translate("Y NOP");
+
+	ASSERT_TRUE(word2->is_ready());
+	ASSERT_EQ(4, Command{word2->value}.address());
+}
+
+TEST_F(LineTranslatorTest, Word_Waiting_For_Few_Symbols_Is_Resolved_After_All_Are_Defined)
+{
+	auto word = translate(" LDA X+1F");
+	ASSERT_EQ((std::vector<Symbol>{"X", Symbol::FromString("1F")}), word->forward_references);
+
+	translate("1H NOP");
+	ASSERT_FALSE(word->is_ready());
+	ASSERT_EQ(std::vector<Symbol>{"X"}, word->forward_references);
+
+	translate("X NOP");
+	ASSERT_TRUE(word->is_ready());
+	ASSERT_EQ(3, Command{word->value}.address());
+}
+
+TEST_F(LineTranslatorTest, Forward_Local_Symbol_Is_Resolved_By_Next_Definition_Only)
+{
+	translator_.set_current_address(100);
+	auto word = translate(" JMP 2F");
+
+	// Placed before the word
+	translator_.set_current_address(10);
+	translate("2H NOP");
+	ASSERT_FALSE(word->is_ready());
+
+	translator_.set_current_address(200);
+	translate("2H NOP");
+	ASSERT_TRUE(word->is_ready());
+	ASSERT_EQ(200, Command{word->value}.address());
+}
+
+TEST_F(LineTranslatorTest, Known_Part_Of_Address_Is_Folded_Before_Forward_Reference)
+{
+	translate("N EQU 10");
+	translator_.set_current_address(100);
+	auto word = translate(" LDA N*2+*+X-1");
+	ASSERT_FALSE(word->is_ready());
+	ASSERT_EQ(3u, word->folded_tokens_count);
+	ASSERT_EQ(Word(120), word->folded_address);
+
+	translate("X NOP");
+	ASSERT_TRUE(word->is_ready());
+	ASSERT_EQ(120 + 101 - 1, Command{word->value}.address());
+}
+
+TEST_F(LineTranslatorTest, Address_That_Starts_With_Forward_Reference_Is_Not_Folded)
+{
+	translate("N EQU 10");
+	auto word = translate(" LDA X+N");
+	ASSERT_EQ(0u, word->folded_tokens_count);
+
+	translate("X NOP");
+	ASSERT_TRUE(word->is_ready());
+	ASSERT_EQ(11, Command{word->value}.address());
+}
+
+TEST_F(LineTranslatorTest, Translated_Words_Stay_Valid_While_Translator_Is_Alive)
+{
+	translator_.set_current_address(100);
+	auto first = translate(" JMP LAST");
+	auto constant = translate(" CON 7");
+
+	std::vector<FutureTranslatedWordRef> words;
+	for (int i = 0; i < 1000; ++i)
+	{
+		words.push_back(translate(" NOP"));
+	}
+	translate("LAST NOP");
+
+	ASSERT_TRUE(first->is_ready());
+	ASSERT_EQ(1102, Command{first->value}.address());
+	ASSERT_EQ(101, constant->original_address);
+	ASSERT_EQ(Word(7), constant->value);
+	for (int i = 0; i < 1000; ++i)
+	{
+		ASSERT_EQ(102 + i, words[static_cast<std::size_t>(i)]->original_address);
+	}
+}
+
+TEST_F(LineTranslatorTest, Lines_Are_Translated_Until_END_And_Words_Are_Collected)
+{
+	const std::vector<std::string_view> lines{
+		" ORIG 100",
+		"START LDA X",
+		"",
+		"X CON 5",
+		" END START",
+		" HLT"};
+	std::size_t translated_count = 0;
+	const auto translated = TranslateLinesUntilEnd(lines.size(), [&](std::size_t index)
+	{
+		++translated_count;
+		return TranslateParsedLine(translator_, ParseLine(lines[index]));
+	});
+
+	ASSERT_EQ(5u, translated_count);
+	ASSERT_EQ(5u, translated.lines.size());
+	ASSERT_EQ(100, translated.program.start_address);
+	ASSERT_EQ(2u, translated.program.commands.size());
+	ASSERT_EQ(101, translated.program.commands[1].original_address);
+	ASSERT_EQ((std::vector<int>{1, 3}), translated.words_lines);
+}
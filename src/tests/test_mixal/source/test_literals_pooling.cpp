@@ -0,0 +1,124 @@
+#include <mixal/line_translator.h>
+#include <mixal/translator.h>
+#include <mixal/parallel_translator.h>
+#include <mixal/program_image.h>
+
+#include <mix/command.h>
+
+#include <gtest_all.h>
+
+#include <vector>
+
+using namespace mixal;
+using namespace mix;
+
+namespace {
+
+class LiteralsPoolingTest :
+	public ::testing::Test
+{
+protected:
+	// Returns words generated by END
+	std::vector<TranslatedWord> translate(std::initializer_list<const char*> lines)
+	{
+		LinesTranslator lines_translator{translator_};
+		for (const char* line : lines)
+		{
+			auto translated = lines_translator.translate(line);
+			if (translated.word_ref)
+			{
+				words_.push_back(translated.word_ref);
+			}
+			if (translated.end_code)
+			{
+				std::vector<TranslatedWord> end_words;
+				for (const auto& symbol_word : translated.end_code->defined_symbols)
+				{
+					end_words.push_back(symbol_word.second);
+				}
+				return end_words;
+			}
+		}
+		return {};
+	}
+
+	int address_of_word(std::size_t index) const
+	{
+		return Command{words_[index]->value}.address();
+	}
+
+protected:
+	Translator translator_;
+	std::vector<FutureTranslatedWordRef> words_;
+};
+
+} // namespace
+
+TEST_F(LiteralsPoolingTest, Every_Literal_Has_Own_Word_By_Default)
+{
+	const auto end_words = translate({
+		" ORIG 100",
+		" LDA =5=",
+		" LDX =5=",
+		" END 100"});
+
+	ASSERT_EQ(2u, end_words.size());
+	ASSERT_EQ(102, address_of_word(0));
+	ASSERT_EQ(103, address_of_word(1));
+}
+
+TEST_F(LiteralsPoolingTest, Literals_With_The_Same_Value_Share_Single_Word)
+{
+	translator_.set_literals_pooling(LiteralsPooling::SameValues);
+	const auto end_words = translate({
+		" ORIG 100",
+		" LDA =5=",
+		" LDX =2+3=",
+		" LD1 =-5=",
+		" LD2 =Y=",
+		" LD3 =5=",
+		"Y EQU 5",
+		" END 100"});
+
+	// Value of `=Y=` is known only on END
+	ASSERT_EQ(2u, end_words.size());
+	ASSERT_EQ(Word(5), end_words[0].value);
+	ASSERT_EQ(Word(WordValue{Sign::Negative, 5}), end_words[1].value);
+
+	ASSERT_EQ(105, address_of_word(0));
+	ASSERT_EQ(105, address_of_word(1));
+	ASSERT_EQ(106, address_of_word(2));
+	ASSERT_EQ(105, address_of_word(3));
+	ASSERT_EQ(105, address_of_word(4));
+}
+
+TEST_F(LiteralsPoolingTest, Literal_Refers_To_CON_Word_With_The_Same_Value)
+{
+	translator_.set_literals_pooling(LiteralsPooling::SameValuesAndCON);
+	const auto end_words = translate({
+		" ORIG 100",
+		" LDA =7=",
+		" LDX =8=",
+		"SEVEN CON 7",
+		" END 100"});
+
+	ASSERT_EQ(1u, end_words.size());
+	ASSERT_EQ(Word(8), end_words[0].value);
+	ASSERT_EQ(102, address_of_word(0));
+	ASSERT_EQ(103, address_of_word(1));
+}
+
+TEST(LiteralsPoolingProgramTest, Is_Applied_By_Program_Translation)
+{
+	const SourceBuffer source{
+		" ORIG 100\n"
+		" LDA =5=\n"
+		" LDX =5=\n"
+		" END 100\n"};
+
+	ParallelTranslateOptions options;
+	options.literals_pooling = LiteralsPooling::SameValues;
+	ASSERT_EQ(3u, TranslateProgramParallel(source, options).commands.size());
+	ASSERT_EQ(3u, TranslateProgramImage(source, LiteralsPooling::SameValues).program.commands.size());
+	ASSERT_EQ(4u, TranslateProgramImage(source).program.commands.size());
+}
@@ -0,0 +1,93 @@
+#include <mixal/mdk_program_loader.h>
+#include <mixal/program_image.h>
+#include <mixal/exceptions.h>
+
+#include <gtest_all.h>
+
+#include <sstream>
+
+using namespace mixal;
+
+namespace {
+
+MDKProgram MakeProgram()
+{
+	MDKProgram mdk_program;
+	auto& program = mdk_program.program;
+	program.start_address = 100;
+	program.commands.push_back({100, Word(42)});
+	program.commands.push_back({101, Word(mix::WordValue{mix::Sign::Negative, 7})});
+	// Gap in addresses
+	program.commands.push_back({2000, Word(mix::WordValue{mix::Sign::Negative, 0})});
+	mdk_program.source_path = "program.mixal";
+	return mdk_program;
+}
+
+MDKProgram WriteAndParse(const MDKProgram& mdk_program)
+{
+	std::ostringstream out;
+	WriteMDKProgram(out, mdk_program);
+	return ParseMDKProgram(out.str());
+}
+
+void AssertSamePrograms(const TranslatedProgram& expected, const TranslatedProgram& actual)
+{
+	ASSERT_EQ(expected.start_address, actual.start_address);
+	ASSERT_EQ(expected.commands.size(), actual.commands.size());
+	for (std::size_t i = 0; i < expected.commands.size(); ++i)
+	{
+		ASSERT_EQ(expected.commands[i].original_address, actual.commands[i].original_address);
+		ASSERT_EQ(expected.commands[i].value, actual.commands[i].value);
+		ASSERT_EQ(expected.commands[i].value.sign(), actual.commands[i].value.sign());
+	}
+}
+
+} // namespace
+
+TEST(MDKProgramTest, Release_Code_File_Is_Read_Back_Without_Changes)
+{
+	const auto expected = MakeProgram();
+	const auto actual = WriteAndParse(expected);
+
+	AssertSamePrograms(expected.program, actual.program);
+	ASSERT_EQ(expected.source_path, actual.source_path);
+	ASSERT_TRUE(actual.lines.empty());
+	ASSERT_TRUE(actual.symbols.empty());
+}
+
+TEST(MDKProgramTest, Debug_Code_File_Keeps_Lines_And_Symbols)
+{
+	auto expected = MakeProgram();
+	expected.lines = {3, 4, 10};
+	expected.symbols = {{"START", 100}, {"NEG", -5}};
+	const auto actual = WriteAndParse(expected);
+
+	AssertSamePrograms(expected.program, actual.program);
+	ASSERT_EQ(expected.lines, actual.lines);
+	ASSERT_EQ(expected.symbols, actual.symbols);
+}
+
+TEST(MDKProgramTest, Translated_Program_Is_Loaded_From_Stream)
+{
+	const auto image = TranslateProgramImage(SourceBuffer{
+		" ORIG 3000\n"
+		"START LDA =-1=\n"
+		" HLT\n"
+		" END START\n"});
+
+	MDKProgram mdk_program;
+	mdk_program.program = image.program;
+	mdk_program.lines = image.lines;
+
+	std::stringstream stream;
+	WriteMDKProgram(stream, mdk_program);
+	AssertSamePrograms(image.program, ParseProgramFromMDKStream(stream));
+}
+
+TEST(MDKProgramTest, Truncated_Header_Throws)
+{
+	std::ostringstream out;
+	WriteMDKProgram(out, MakeProgram());
+	ASSERT_THROW(ParseMDKProgram(out.str().substr(0, 10)), CorruptedMDKStream);
+	ASSERT_THROW(ParseMDKProgram(std::string(64, 'x')), CorruptedMDKStream);
+}
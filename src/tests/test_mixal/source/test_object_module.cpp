@@ -0,0 +1,246 @@
+#include <mixal/object_module.h>
+#include <mixal/program_executor.h>
+#include <mixal/exceptions.h>
+
+#include <mix/command.h>
+
+#include <gtest_all.h>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace mixal;
+
+namespace {
+
+const char* const k_main_module =
+	"TERM EQU 19\n"
+	"START JMP PRINT\n"
+	" LDA =1=\n"
+	" STA VALUE\n"
+	" HLT\n"
+	"VALUE CON 0\n"
+	"POINTER CON START\n"
+	" END START\n";
+
+const char* const k_print_module =
+	"TERM EQU 19\n"
+	"PRINT JMP 1F\n"
+	"1H NOP\n"
+	"1H JMP START+1\n"
+	" END PRINT\n";
+
+ObjectModule WriteAndRead(const ObjectModule& module)
+{
+	std::stringstream stream;
+	WriteObjectModule(stream, module);
+	return ReadObjectModule(stream);
+}
+
+int AddressOf(const TranslatedProgram& program, int address)
+{
+	for (const auto& word : program.commands)
+	{
+		if (word.original_address == address)
+		{
+			return mix::Command{word.value}.address();
+		}
+	}
+	throw std::logic_error{"no word"};
+}
+
+} // namespace
+
+TEST(ObjectModuleTest, Undefined_Symbols_Are_Imported_And_Labels_Are_Exported)
+{
+	const auto module = TranslateModule(SourceBuffer{k_main_module});
+
+	ASSERT_EQ(std::vector<std::string>{"PRINT"}, module.imports);
+	ASSERT_EQ(0, module.start_address);
+	ASSERT_TRUE(module.start_relocatable);
+	// 6 words + literal constant
+	ASSERT_EQ(7u, module.words.size());
+
+	const auto find_export = [&](const std::string& name)
+	{
+		for (const auto& symbol : module.exports)
+		{
+			if (symbol.name == name)
+			{
+				return symbol;
+			}
+		}
+		throw std::logic_error{"no export"};
+	};
+	ASSERT_FALSE(find_export("TERM").relocatable);
+	ASSERT_TRUE(find_export("VALUE").relocatable);
+	ASSERT_EQ(Word(4), find_export("VALUE").value);
+}
+
+TEST(ObjectModuleTest, Module_Is_Read_Back_Without_Changes)
+{
+	const auto module = TranslateModule(SourceBuffer{k_main_module});
+	const auto read = WriteAndRead(module);
+
+	ASSERT_EQ(module.imports, read.imports);
+	ASSERT_EQ(module.start_address, read.start_address);
+	ASSERT_EQ(module.words.size(), read.words.size());
+	ASSERT_EQ(module.relocations.size(), read.relocations.size());
+	ASSERT_EQ(module.exports.size(), read.exports.size());
+	for (std::size_t i = 0; i < module.words.size(); ++i)
+	{
+		ASSERT_EQ(module.words[i].value, read.words[i].value);
+	}
+}
+
+TEST(ObjectModuleTest, Linked_Modules_Give_The_Same_Program_As_Single_Source)
+{
+	const auto linked = LinkModules({
+		TranslateModule(SourceBuffer{k_main_module}),
+		TranslateModule(SourceBuffer{k_print_module})},
+		100);
+
+	ASSERT_EQ(100, linked.start_address);
+	ASSERT_EQ(107, AddressOf(linked, 100));		// JMP PRINT
+	ASSERT_EQ(106, AddressOf(linked, 101));		// LDA =1=
+	ASSERT_EQ(104, AddressOf(linked, 102));		// STA VALUE
+	ASSERT_EQ(108, AddressOf(linked, 107));		// JMP 1F
+	ASSERT_EQ(101, AddressOf(linked, 109));		// JMP START+1
+
+	for (const auto& word : linked.commands)
+	{
+		if (word.original_address == 105)
+		{
+			ASSERT_EQ(Word(100), word.value);	// CON START
+		}
+	}
+}
+
+TEST(ObjectModuleTest, Link_Errors)
+{
+	const auto main_module = TranslateModule(SourceBuffer{k_main_module});
+	ASSERT_THROW(LinkModules({main_module}), LinkError);
+	ASSERT_THROW(LinkModules({main_module, main_module,
+		TranslateModule(SourceBuffer{k_print_module})}), LinkError);
+}
+
+TEST(ObjectModuleTest, Not_Relocatable_Code_Is_Rejected)
+{
+	ASSERT_THROW(TranslateModule(SourceBuffer{
+		" ORIG 100\n"
+		"X NOP\n"
+		" END X\n"}), ObjectModuleError);
+
+	ASSERT_THROW(TranslateModule(SourceBuffer{
+		"X NOP\n"
+		" LDA 2*X\n"
+		" END X\n"}), ObjectModuleError);
+
+	// Both for even and odd addresses
+	ASSERT_THROW(TranslateModule(SourceBuffer{
+		"X NOP\n"
+		" LDA LAB/2\n"
+		"LAB CON 0\n"
+		" END X\n"}), ObjectModuleError);
+	ASSERT_THROW(TranslateModule(SourceBuffer{
+		"X NOP\n"
+		" LDA LAB/2\n"
+		" NOP\n"
+		"LAB CON 0\n"
+		" END X\n"}), ObjectModuleError);
+	ASSERT_THROW(TranslateModule(SourceBuffer{
+		"X LDA EXT/2\n"
+		" END X\n"}), ObjectModuleError);
+}
+
+TEST(ObjectModuleTest, Not_Relocatable_Symbols_Are_Not_Exported)
+{
+	for (const char* label_offset : {"", " NOP\n"})
+	{
+		const auto module = TranslateModule(SourceBuffer{
+			std::string{"X NOP\n"} + label_offset +
+			"LAB NOP\n"
+			"HALF EQU LAB/2\n"
+			"ABS EQU 10\n"
+			" END X\n"});
+		std::vector<std::string> exported;
+		for (const auto& symbol : module.exports)
+		{
+			exported.push_back(symbol.name);
+		}
+		std::sort(exported.begin(), exported.end());
+		ASSERT_EQ((std::vector<std::string>{"ABS", "LAB", "X"}), exported);
+	}
+}
+
+TEST(ObjectModuleTest, Labels_Defined_By_Few_Modules_Are_Private)
+{
+	const auto first = TranslateModule(SourceBuffer{
+		"START JMP LOOP\n"
+		"LOOP JMP PRINT\n"
+		"2H NOP\n"
+		" END START\n"});
+	const auto second = TranslateModule(SourceBuffer{
+		"PRINT NOP\n"
+		"LOOP JMP LOOP\n"
+		"2H NOP\n"
+		" END PRINT\n"});
+	for (const auto& symbol : first.exports)
+	{
+		ASSERT_NE("2H", symbol.name);
+	}
+
+	const auto linked = LinkModules({first, second});
+	ASSERT_EQ(1, AddressOf(linked, 0));		// JMP LOOP of the first module
+	ASSERT_EQ(3, AddressOf(linked, 1));		// JMP PRINT
+	ASSERT_EQ(4, AddressOf(linked, 4));		// JMP LOOP of the second module
+
+	const auto user = TranslateModule(SourceBuffer{
+		"X JMP LOOP\n"
+		" END X\n"});
+	ASSERT_THROW(LinkModules({first, second, user}), LinkError);
+}
+
+TEST(ObjectModuleTest, Memory_Reserved_At_The_End_Is_Part_Of_Module)
+{
+	const auto first = TranslateModule(SourceBuffer{
+		"START LDA BUF\n"
+		"BUF ORIG *+10\n"
+		" END START\n"});
+	ASSERT_EQ(11, first.size);
+	ASSERT_EQ(11, WriteAndRead(first).size);
+
+	const auto linked = LinkModules({first, TranslateModule(SourceBuffer{
+		"NEXT NOP\n"
+		" END NEXT\n"})});
+	ASSERT_EQ(2u, linked.commands.size());
+	ASSERT_EQ(11, linked.commands[1].original_address);
+}
+
+TEST(ObjectModuleTest, Symbols_Can_Not_Depend_On_Imports)
+{
+	ASSERT_THROW(TranslateModule(SourceBuffer{
+		"START LDA EXT\n"
+		"X EQU EXT+1\n"
+		" END START\n"}), UndefinedSymbolError);
+}
+
+TEST(ObjectModuleTest, Broken_Module_Is_Not_Read)
+{
+	std::stringstream stream;
+	WriteObjectModule(stream, TranslateModule(SourceBuffer{k_main_module}));
+	const auto data = stream.str();
+
+	// Words count is at offset 24
+	auto big_count = data;
+	big_count.replace(24, 4, std::string(4, '\xFF'));
+	std::istringstream big_count_stream{big_count};
+	ASSERT_THROW(ReadObjectModule(big_count_stream), ObjectModuleError);
+
+	// Kind of the first relocation goes after 8-byte header fields,
+	// 7 words and word index of relocation
+	auto bad_kind = data;
+	bad_kind[40 + 7 * 8 + 4] = 7;
+	std::istringstream bad_kind_stream{bad_kind};
+	ASSERT_THROW(ReadObjectModule(bad_kind_stream), ObjectModuleError);
+}
@@ -0,0 +1,76 @@
+#include <mixal/parallel_translator.h>
+#include <mixal/program_executor.h>
+#include <mixal/exceptions.h>
+
+#include <gtest_all.h>
+
+#include <string>
+
+using namespace mixal;
+
+namespace {
+
+std::string MakeLongProgram(int blocks_count)
+{
+	std::string text = " ORIG 100\n";
+	for (int i = 0; i < blocks_count; ++i)
+	{
+		const auto label = "L" + std::to_string(i);
+		text += label + " LDA =" + std::to_string(i) + "=\n";
+		text += "2H ADD " + label + "\n";
+		text += " JMP 2F\n";
+		text += " JMP 2B\n";
+		text += "2H STA NEXT" + std::to_string(i) + "\n";
+		text += "NEXT" + std::to_string(i) + " CON " + std::to_string(i) + "\n";
+		text += " ALF ABCDE\n";
+		text += "* comment\n\n";
+	}
+	text += " HLT\n";
+	text += " END L0\n";
+	// Ignored, since it's after END
+	text += "not a valid line\n";
+	return text;
+}
+
+void AssertSamePrograms(const TranslatedProgram& expected, const TranslatedProgram& actual)
+{
+	ASSERT_EQ(expected.start_address, actual.start_address);
+	ASSERT_EQ(expected.commands.size(), actual.commands.size());
+	for (std::size_t i = 0; i < expected.commands.size(); ++i)
+	{
+		ASSERT_EQ(expected.commands[i].original_address, actual.commands[i].original_address);
+		ASSERT_EQ(expected.commands[i].value, actual.commands[i].value);
+	}
+}
+
+} // namespace
+
+TEST(ParallelTranslatorTest, Gives_The_Same_Program_As_Sequential_Translation)
+{
+	const SourceBuffer source{MakeLongProgram(300)};
+	const auto expected = TranslateProgram(source);
+	ASSERT_EQ(100, expected.start_address);
+
+	for (std::size_t chunk_lines : {1, 7, 100, 100000})
+	{
+		ParallelTranslateOptions options;
+		options.threads_count = 4;
+		options.chunk_lines = chunk_lines;
+		AssertSamePrograms(expected, TranslateProgramParallel(source, options));
+	}
+}
+
+TEST(ParallelTranslatorTest, Reports_First_Error_In_Order_Of_Lines)
+{
+	const SourceBuffer source{
+		" ORIG 100\n"
+		"X NOP\n"
+		"X NOP\n"
+		"not a valid line\n"
+		" END 100\n"};
+
+	ParallelTranslateOptions options;
+	options.chunk_lines = 1;
+	ASSERT_THROW(TranslateProgram(source), DuplicateSymbolDefinitionError);
+	ASSERT_THROW(TranslateProgramParallel(source, options), DuplicateSymbolDefinitionError);
+}
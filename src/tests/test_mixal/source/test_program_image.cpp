@@ -0,0 +1,149 @@
+#include <mixal/program_image.h>
+#include <mixal/program_executor.h>
+#include <mixal/exceptions.h>
+
+#include <gtest_all.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace mixal;
+
+namespace {
+
+const char* const k_source =
+	" ORIG 100\n"
+	"START LDA =-5=\n"
+	"* comment\n"
+	" JMP NEXT\n"
+	"NEXT HLT\n"
+	"VALUE CON -0\n"
+	" END START\n";
+
+ProgramImage WriteAndRead(const ProgramImage& image)
+{
+	std::stringstream stream;
+	WriteProgramImage(stream, image);
+	return ReadProgramImage(stream);
+}
+
+void AssertSameImages(const ProgramImage& expected, const ProgramImage& actual)
+{
+	ASSERT_EQ(expected.source_hash, actual.source_hash);
+	ASSERT_EQ(expected.program.start_address, actual.program.start_address);
+	ASSERT_EQ(expected.program.commands.size(), actual.program.commands.size());
+	for (std::size_t i = 0; i < expected.program.commands.size(); ++i)
+	{
+		const auto& lhs = expected.program.commands[i];
+		const auto& rhs = actual.program.commands[i];
+		ASSERT_EQ(lhs.original_address, rhs.original_address);
+		ASSERT_EQ(lhs.value, rhs.value);
+		ASSERT_EQ(lhs.value.sign(), rhs.value.sign());
+	}
+	ASSERT_EQ(expected.lines, actual.lines);
+	ASSERT_EQ(expected.symbols, actual.symbols);
+}
+
+} // namespace
+
+TEST(ProgramImageTest, Contains_The_Same_Program_As_TranslateProgram)
+{
+	const SourceBuffer source{k_source};
+	const auto expected = TranslateProgram(source);
+	const auto image = TranslateProgramImage(source);
+
+	ASSERT_EQ(expected.start_address, image.program.start_address);
+	ASSERT_EQ(expected.commands.size(), image.program.commands.size());
+	ASSERT_EQ((std::vector<int>{2, 4, 5, 6, 7}), image.lines);
+
+	const auto next = std::find_if(image.symbols.cbegin(), image.symbols.cend(),
+		[](const std::pair<std::string, Word>& symbol)
+	{
+		return (symbol.first == "NEXT");
+	});
+	ASSERT_NE(next, image.symbols.cend());
+	ASSERT_EQ(Word(102), next->second);
+}
+
+TEST(ProgramImageTest, Is_Read_Back_Without_Changes)
+{
+	const auto image = TranslateProgramImage(SourceBuffer{k_source});
+	AssertSameImages(image, WriteAndRead(image));
+}
+
+TEST(ProgramImageTest, Corrupted_Or_Truncated_Image_Is_Not_Read)
+{
+	std::stringstream stream;
+	WriteProgramImage(stream, TranslateProgramImage(SourceBuffer{k_source}));
+	const auto data = stream.str();
+
+	std::istringstream truncated{data.substr(0, data.size() - 1)};
+	ASSERT_THROW(ReadProgramImage(truncated), CorruptedProgramImage);
+
+	auto other_version = data;
+	other_version[8] = 2;
+	std::istringstream other_version_stream{other_version};
+	ASSERT_THROW(ReadProgramImage(other_version_stream), CorruptedProgramImage);
+}
+
+TEST(ProgramImageTest, Image_With_Too_Big_Counts_Is_Not_Read)
+{
+	std::stringstream stream;
+	WriteProgramImage(stream, TranslateProgramImage(SourceBuffer{k_source}));
+	const auto data = stream.str();
+
+	// Words count is at offset 24, symbols count - at offset 28
+	for (std::size_t offset : {24u, 28u})
+	{
+		auto broken = data;
+		broken.replace(offset, 4, std::string(4, '\xFF'));
+		std::istringstream broken_stream{broken};
+		ASSERT_THROW(ReadProgramImage(broken_stream), CorruptedProgramImage);
+	}
+}
+
+TEST(ProgramImageTest, Cache_Returns_Image_Of_Unchanged_Source)
+{
+	const auto cache_dir = std::filesystem::path{::testing::TempDir()} / "mixal_image_cache_test";
+	std::filesystem::remove_all(cache_dir);
+
+	const SourceBuffer source{k_source};
+	const auto translated = LoadOrTranslateProgramImage(source, cache_dir.string());
+	ASSERT_FALSE(std::filesystem::is_empty(cache_dir));
+	// Images of other translator versions are not found
+	const std::string translator_version = ".t" + std::to_string(Translator::k_version) + ".";
+	for (const auto& entry : std::filesystem::directory_iterator{cache_dir})
+	{
+		ASSERT_NE(std::string::npos, entry.path().filename().string().find(translator_version));
+	}
+
+	const auto cached = LoadOrTranslateProgramImage(source, cache_dir.string());
+	AssertSameImages(translated, cached);
+
+	const auto changed = LoadOrTranslateProgramImage(
+		SourceBuffer{std::string{k_source} + "\n"}, cache_dir.string());
+	ASSERT_NE(translated.source_hash, changed.source_hash);
+
+	std::filesystem::remove_all(cache_dir);
+}
+
+TEST(ProgramImageTest, Source_Is_Translated_Again_If_Cached_Image_Is_Broken)
+{
+	const auto cache_dir = std::filesystem::path{::testing::TempDir()} / "mixal_broken_image_cache_test";
+	std::filesystem::remove_all(cache_dir);
+
+	const SourceBuffer source{k_source};
+	const auto translated = LoadOrTranslateProgramImage(source, cache_dir.string());
+	for (const auto& entry : std::filesystem::directory_iterator{cache_dir})
+	{
+		std::fstream file{entry.path(), std::ios_base::binary | std::ios_base::in | std::ios_base::out};
+		file.seekp(28);
+		file.write("\xFF\xFF\xFF\xFF", 4);
+	}
+
+	const auto cached = LoadOrTranslateProgramImage(source, cache_dir.string());
+	AssertSameImages(translated, cached);
+
+	std::filesystem::remove_all(cache_dir);
+}
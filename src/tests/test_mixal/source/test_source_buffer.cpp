@@ -0,0 +1,70 @@
+#include <mixal/source_buffer.h>
+#include <mixal/program_executor.h>
+#include <mixal/exceptions.h>
+
+#include <mix/command.h>
+
+#include <gtest_all.h>
+
+#include <sstream>
+
+using namespace mixal;
+
+TEST(SourceBufferTest, Splits_Lines_Like_Getline)
+{
+	const SourceBuffer source{"FIRST\n\nTHIRD\r\nLAST"};
+
+	const auto& lines = source.lines();
+	ASSERT_EQ(4u, lines.size());
+	ASSERT_EQ("FIRST", lines[0]);
+	ASSERT_EQ("", lines[1]);
+	ASSERT_EQ("THIRD\r", lines[2]);
+	ASSERT_EQ("LAST", lines[3]);
+
+	ASSERT_EQ(1u, SourceBuffer{"ONE\n"}.lines().size());
+	ASSERT_TRUE(SourceBuffer{""}.lines().empty());
+}
+
+TEST(SourceBufferTest, Lines_Point_Into_Single_Buffer_That_Survives_Move)
+{
+	SourceBuffer source{"A\nB"};
+	const auto text = source.text();
+
+	const SourceBuffer moved = std::move(source);
+	ASSERT_EQ(text.data(), moved.text().data());
+	ASSERT_EQ(text.data() + 2, moved.lines()[1].data());
+}
+
+TEST(SourceBufferTest, Program_Is_Translated_From_Buffer)
+{
+	std::istringstream in{
+		" ORIG 100\n"
+		"START JMP NEXT\n"
+		"NEXT HLT\n"
+		" END START\n"};
+
+	const auto program = TranslateProgram(in);
+	ASSERT_EQ(100, program.start_address);
+	ASSERT_EQ(2u, program.commands.size());
+	ASSERT_EQ(101, mix::Command{program.commands[0].value}.address());
+}
+
+TEST(SourceBufferTest, Stream_Is_Read_Only_Till_END)
+{
+	std::istringstream in{
+		"START HLT\n"
+		" END START\n"
+		"DATA AFTER END\n"};
+
+	const auto program = TranslateProgram(in);
+	ASSERT_EQ(0, program.start_address);
+
+	std::string rest;
+	ASSERT_TRUE(std::getline(in, rest));
+	ASSERT_EQ("DATA AFTER END", rest);
+}
+
+TEST(SourceBufferTest, Throws_When_File_Can_Not_Be_Opened)
+{
+	ASSERT_THROW(SourceBuffer::FromFile("not/existing/file.mixal"), SourceFileOpenError);
+}
@@ -1,5 +1,6 @@
 #include <mixal/translator.h>
 #include <mixal/exceptions.h>
+#include <mixal/operation_info.h>
 
 #include <mixal_parse/expression_parser.h>
 #include <mixal_parse/w_value_parser.h>
@@ -7,6 +8,7 @@
 #include <mix/exceptions.h>
 #include <mix/char_table.h>
 #include <mix/computer.h>
+#include <mix/command.h>
 
 #include <core/utils.h>
 
@@ -364,3 +366,31 @@ TEST_F(ExpressionEvaluateTest, WValue_With_Too_Big_Field_For_Single_Word_Throws_
 }
 
 
+
+TEST(OperationInfoTest, Command_Is_Decoded_To_The_Same_Operation)
+{
+	for (int i = 0; i <= static_cast<int>(OperationId::MIXOpEnd); ++i)
+	{
+		const auto id = static_cast<OperationId>(i);
+		const auto info = QueryOperationInfo(Operation{id});
+		ASSERT_EQ(id, info.id);
+		if (info.computer_command < 0)
+		{
+			// Not supported by MIX computer
+			continue;
+		}
+
+		const Command command{static_cast<std::size_t>(info.computer_command),
+			0, 0, info.default_field};
+		ASSERT_EQ(id, QueryOperationInfo(command).id) << OperationIdToString(id);
+	}
+
+	for (int i = static_cast<int>(OperationId::MIXALOpBegin); i <= static_cast<int>(OperationId::MIXALOpEnd); ++i)
+	{
+		ASSERT_THROW(QueryOperationInfo(Operation{static_cast<OperationId>(i)}), InvalidOperationId);
+	}
+	// Unknown field of command with several operations
+	ASSERT_EQ(OperationId::Unknown, QueryOperationInfo(Command{5, 0, 0, WordField{7, 7}}).id);
+	// Any field of command with single operation
+	ASSERT_EQ(OperationId::LDA, QueryOperationInfo(Command{8, 0, 0, WordField{7, 7}}).id);
+}
@@ -149,3 +149,20 @@ TEST(TranslatorSymbolsTest, Backward_Local_Symbol_Value_Depends_On_Local_Id)
 }
 
 
+
+TEST(TranslatorSymbolsTest, Symbols_Passed_To_Constructor_Can_Be_Queried)
+{
+	Translator translator{
+		{{Symbol::FromString("X"), Word(42)}},
+		{{LocalSymbolId{5}, {3000, 100, 2000}}}};
+
+	ASSERT_EQ(Word(42), translator.query_defined_symbol("X"));
+	ASSERT_THROW({
+		translator.define_symbol("X", Word(1));
+	}, DuplicateSymbolDefinitionError);
+
+	ASSERT_EQ(Word(100), translator.query_defined_symbol(Symbol::FromString("5B"), 1999));
+	ASSERT_EQ(Word(2000), translator.query_defined_symbol(Symbol::FromString("5B"), 2000));
+	ASSERT_EQ(Word(2000), translator.query_defined_symbol(Symbol::FromString("5F"), 101));
+	ASSERT_EQ(Word(3000), translator.query_defined_symbol(Symbol::FromString("5F"), 2001));
+}
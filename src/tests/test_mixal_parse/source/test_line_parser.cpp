@@ -134,3 +134,12 @@ TEST_F(LineParserTest, When_Label_Name_Is_Valid_Operation_And_Line_Has_Valid_Ope
 	has_address_str("IN");
 }
 
+
+TEST_F(LineParserTest, When_Second_Operation_Is_Not_Valid_ADDRESS_Of_The_First_One_Then_First_Operation_Is_Label)
+{
+	parse("ALF LDA");
+
+	has_label("ALF");
+	has_operation(OperationId::LDA);
+	has_address_str("");
+}
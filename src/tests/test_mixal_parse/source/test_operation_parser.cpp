@@ -98,3 +98,21 @@ DEF_INSTANTIATE_TEST_CASE_P(ValidOperationStrings,
 		));
 
 
+
+TEST(OperationIdTest, All_Operations_Names_Round_Trip)
+{
+	for (int i = 0; i < static_cast<int>(OperationId::Count); ++i)
+	{
+		const auto id = static_cast<OperationId>(i);
+		const auto name = OperationIdToString(id);
+		ASSERT_FALSE(name.empty()) << i;
+		ASSERT_EQ(id, OperationIdFromString(name)) << name;
+	}
+
+	ASSERT_TRUE(OperationIdToString(OperationId::Unknown).empty());
+	ASSERT_TRUE(OperationIdToString(OperationId::Count).empty());
+	ASSERT_EQ(OperationId::Unknown, OperationIdFromString(""));
+	ASSERT_EQ(OperationId::Unknown, OperationIdFromString("lda"));
+	ASSERT_EQ(OperationId::Unknown, OperationIdFromString("LDAX"));
+	ASSERT_EQ(OperationId::Unknown, OperationIdFromString("IN_"));
+}
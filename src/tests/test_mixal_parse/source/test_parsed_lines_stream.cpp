@@ -0,0 +1,63 @@
+#include <mixal_parse/parsed_lines_stream.h>
+
+#include <gtest_all.h>
+
+#include <cctype>
+
+using namespace mixal_parse;
+
+TEST(ParsedLinesStreamTest, Parses_Every_Line_And_Reports_Empty_And_Invalid_Ones)
+{
+	core::LineReader reader{core::ByteSource::FromMemory(
+		"* COMMENT\n"
+		"START LDA 2000\n"
+		"   \n"
+		"X Y Z\n"
+		" HLT")};
+	ParsedLinesStream lines{reader};
+	ParsedLine line;
+
+	ASSERT_TRUE(lines.next(line));
+	ASSERT_EQ(1u, line.number);
+	ASSERT_TRUE(line.parser);
+	ASSERT_TRUE(line.parser->has_only_comment());
+
+	ASSERT_TRUE(lines.next(line));
+	ASSERT_EQ("START LDA 2000", line.text);
+	ASSERT_TRUE(line.parser);
+	ASSERT_EQ("START", line.parser->label_parser()->label().name());
+	ASSERT_EQ(OperationId::LDA, line.parser->operation_parser()->operation().id());
+
+	ASSERT_TRUE(lines.next(line));
+	ASSERT_TRUE(line.is_empty());
+	ASSERT_FALSE(line.is_invalid());
+	ASSERT_FALSE(line.parser);
+
+	ASSERT_TRUE(lines.next(line));
+	ASSERT_TRUE(line.is_invalid());
+	ASSERT_FALSE(line.parser);
+
+	ASSERT_TRUE(lines.next(line));
+	ASSERT_EQ(5u, line.number);
+	ASSERT_EQ(OperationId::HLT, line.parser->operation_parser()->operation().id());
+
+	ASSERT_FALSE(lines.next(line));
+}
+
+TEST(ParsedLinesStreamTest, Transform_Is_Applied_Before_Parsing)
+{
+	core::LineReader reader{core::ByteSource::FromMemory("x lda 100\n")};
+	ParsedLinesStream lines{reader, [](core::Span<char> str)
+	{
+		for (char& ch : str)
+		{
+			ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+		}
+	}};
+
+	ParsedLine line;
+	ASSERT_TRUE(lines.next(line));
+	ASSERT_EQ("X LDA 100", line.text);
+	ASSERT_TRUE(line.parser);
+	ASSERT_EQ(OperationId::LDA, line.parser->operation_parser()->operation().id());
+}
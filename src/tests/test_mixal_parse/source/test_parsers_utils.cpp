@@ -2,6 +2,10 @@
 
 #include <gtest_all.h>
 
+#include <string>
+
+#include <cctype>
+
 using namespace mixal_parse;
 
 namespace {
@@ -55,3 +59,43 @@ TEST(ParsersUtils, Current_Address_Char_Is_Basic_Expression)
 	ASSERT_TRUE(IsCurrentAddressSymbol("*"));
 	ASSERT_TRUE(IsBasicExpression("*"));
 }
+
+TEST(ParsersUtils, Char_Classes_Match_C_Locale_Functions)
+{
+	for (int i = 0; i < 256; ++i)
+	{
+		const char ch = static_cast<char>(i);
+		const bool is_upper = (ch >= 'A') && (ch <= 'Z');
+		const bool is_digit = (ch >= '0') && (ch <= '9');
+		ASSERT_EQ(std::isspace(i) != 0, IsWhiteSpaceChar(ch)) << i;
+		ASSERT_EQ(is_digit, IsNumberChar(ch)) << i;
+		ASSERT_EQ(is_upper || is_digit, IsSymbolChar(ch)) << i;
+		ASSERT_EQ(is_upper || is_digit || (ch == '*'), IsBasicExpressionChar(ch)) << i;
+	}
+
+	for (char ch : std::string_view{"+-"})
+	{
+		ASSERT_TRUE(IsUnaryOperationBegin(ch)) << ch;
+		ASSERT_TRUE(IsCompletedUnaryOperation(std::string_view{&ch, 1})) << ch;
+	}
+	for (char ch : std::string_view{"+-*/:"})
+	{
+		ASSERT_TRUE(IsBinaryOperationChar(ch)) << ch;
+	}
+	ASSERT_FALSE(IsBinaryOperationChar('='));
+	ASSERT_FALSE(IsUnaryOperationChar('*'));
+}
+
+TEST(ParsersUtils, Finds_White_Spaces_In_Long_Strings)
+{
+	for (std::size_t length = 0; length < 40; ++length)
+	{
+		const std::string spaces = std::string(length, ' ') + "\t\r";
+		const std::string line = spaces + "LDA" + std::string(length, 'X') + "\v1";
+		ASSERT_EQ(spaces.size(), SkipLeftWhiteSpaces(line));
+		ASSERT_EQ(spaces.size() + 3 + length, FindFirstWhiteSpace(line, spaces.size()));
+		ASSERT_EQ(line.size(), FindFirstWhiteSpace(line, line.size() - 1));
+		ASSERT_EQ(spaces.size(), SkipLeftWhiteSpaces(spaces));
+	}
+	ASSERT_EQ(3u, FindFirstWhiteSpace("ABC", 10));
+}
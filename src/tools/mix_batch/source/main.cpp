@@ -0,0 +1,164 @@
+#include <mix_batch/batch_runner.h>
+
+#include <mixal/program_executor.h>
+#include <mixal/mdk_program_loader.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(__clang__)
+#  pragma clang diagnostic push
+// Comes from <regex>, -Wno-sign-compare on command line does not help
+//
+// comparison of integers of different signs
+#  pragma clang diagnostic ignored "-Wsign-compare"
+#endif
+
+#include <cxxopts.hpp>
+
+#if defined(_MSC_VER) && defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+
+using namespace mix_batch;
+
+namespace
+{
+	cxxopts::Options CreateOptions()
+	{
+		cxxopts::Options options{"mix_batch", "Runs MIX program over many inputs in parallel"};
+		options.add_options()
+			("h,help",		"Show this help and exit")
+			("f,file",		"Input file (either MIXAL code or MIX byte-code)", cxxopts::value<std::string>())
+			("m,mdk",		"Interpret <file> as file with GNU MIX Development Kit (MDK) format")
+			("l,manifest",	"File with one `<input file> [commands budget]` task per line", cxxopts::value<std::string>())
+			("t,threads",	"Threads count (all hardware threads by default)", cxxopts::value<int>())
+			("b,budget",	"Commands budget for tasks without own budget", cxxopts::value<int>())
+			("o,output",	"Print output of every task");
+		return options;
+	}
+
+	struct Options
+	{
+		std::string file;
+		std::string manifest;
+		bool mdk_stream = false;
+		bool show_help = false;
+		bool show_output = false;
+		int threads_count = 0;
+		int commands_budget = -1;
+	};
+
+	Options OptionsFromCommandLine(const cxxopts::ParseResult& cmd)
+	{
+		Options options;
+
+		if (cmd["file"].count() == 1)
+		{
+			options.file = cmd["file"].as<std::string>();
+		}
+		if (cmd["manifest"].count() == 1)
+		{
+			options.manifest = cmd["manifest"].as<std::string>();
+		}
+		if (cmd["threads"].count() == 1)
+		{
+			options.threads_count = cmd["threads"].as<int>();
+		}
+		if (cmd["budget"].count() == 1)
+		{
+			options.commands_budget = cmd["budget"].as<int>();
+		}
+		options.show_help = (cmd.count("help") > 0);
+		options.mdk_stream = (cmd.count("mdk") > 0);
+		options.show_output = (cmd.count("output") > 0);
+
+		return options;
+	}
+
+	mixal::TranslatedProgram ReadProgram(const Options& options)
+	{
+		if (options.mdk_stream)
+		{
+			std::ifstream input(options.file, std::ios_base::binary);
+			return mixal::ParseProgramFromMDKStream(input);
+		}
+
+		return mixal::TranslateProgram(mixal::SourceBuffer::FromFile(options.file));
+	}
+
+	std::string ReadFile(const std::string& file_name)
+	{
+		std::ifstream input(file_name, std::ios_base::binary);
+		if (!input)
+		{
+			throw std::runtime_error("Can't open `" + file_name + "` file");
+		}
+		return std::string(std::istreambuf_iterator<char>(input),
+			std::istreambuf_iterator<char>());
+	}
+
+	std::vector<BatchTask> ReadManifest(const Options& options)
+	{
+		std::ifstream manifest(options.manifest);
+		if (!manifest)
+		{
+			throw std::runtime_error("Can't open `" + options.manifest + "` manifest");
+		}
+
+		std::vector<BatchTask> tasks;
+		std::string line;
+		while (std::getline(manifest, line))
+		{
+			std::istringstream fields(line);
+			BatchTask task;
+			if (!(fields >> task.name) || (task.name[0] == '#'))
+			{
+				continue;
+			}
+			if (!(fields >> task.commands_budget))
+			{
+				task.commands_budget = options.commands_budget;
+			}
+			task.input = ReadFile(task.name);
+			tasks.push_back(std::move(task));
+		}
+		return tasks;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		auto cmd_args = CreateOptions();
+		const Options options = OptionsFromCommandLine(cmd_args.parse(argc, argv));
+		if (options.show_help || options.file.empty() || options.manifest.empty())
+		{
+			std::cout << cmd_args.help() << '\n';
+			return 0;
+		}
+
+		const auto program = ReadProgram(options);
+		const auto tasks = ReadManifest(options);
+
+		BatchOptions batch_options;
+		batch_options.threads_count = static_cast<std::size_t>(
+			std::max(0, options.threads_count));
+
+		const auto report = RunBatch(program, tasks, batch_options);
+		PrintReport(std::cout, report, options.show_output);
+		return (report.errors_count == 0) ? 0 : 1;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return -1;
+	}
+}
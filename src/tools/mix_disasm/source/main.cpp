@@ -0,0 +1,165 @@
+#include <mixal/disassembler.h>
+#include <mixal/mdk_program_loader.h>
+#include <mixal/program_image.h>
+#include <mixal/exceptions.h>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#if defined(_MSC_VER) && defined(__clang__)
+#  pragma clang diagnostic push
+// Comes from <regex>, -Wno-sign-compare on command line does not help
+//
+// comparison of integers of different signs
+#  pragma clang diagnostic ignored "-Wsign-compare"
+#endif
+
+#include <cxxopts.hpp>
+
+#if defined(_MSC_VER) && defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+
+using namespace mixal;
+
+namespace
+{
+	cxxopts::Options CreateOptions()
+	{
+		cxxopts::Options options{"mix_disasm",
+			"Disassembles MIX program (MDK code file) to MIXAL"};
+		options.add_options()
+			("h,help",		"Show this help and exit")
+			("i,input",		"Input MDK code file", cxxopts::value<std::string>())
+			("s,source",	"Input MIXAL source that is translated first", cxxopts::value<std::string>())
+			("o,output",	"Output MIXAL file (stdout by default)", cxxopts::value<std::string>())
+			("cfg",			"Print basic blocks of the program instead of MIXAL");
+		return options;
+	}
+
+	struct Options
+	{
+		std::string input;
+		std::string source;
+		std::string output;
+		bool print_cfg = false;
+		bool show_help = false;
+	};
+
+	Options OptionsFromCommandLine(const cxxopts::ParseResult& cmd)
+	{
+		Options options;
+
+		if (cmd["input"].count() == 1)
+		{
+			options.input = cmd["input"].as<std::string>();
+		}
+		if (cmd["source"].count() == 1)
+		{
+			options.source = cmd["source"].as<std::string>();
+		}
+		if (cmd["output"].count() == 1)
+		{
+			options.output = cmd["output"].as<std::string>();
+		}
+		options.print_cfg = (cmd.count("cfg") > 0);
+		options.show_help = (cmd.count("help") > 0);
+
+		return options;
+	}
+
+	std::string ReadFile(const std::string& file_name)
+	{
+		std::ifstream input(file_name, std::ios_base::binary);
+		if (!input)
+		{
+			throw std::runtime_error("Can't open `" + file_name + "` file");
+		}
+		std::ostringstream buffer;
+		buffer << input.rdbuf();
+		return buffer.str();
+	}
+
+	MDKProgram LoadProgram(const Options& options)
+	{
+		if (!options.input.empty())
+		{
+			return ParseMDKProgram(ReadFile(options.input));
+		}
+
+		auto image = TranslateProgramImage(SourceBuffer::FromFile(options.source));
+		MDKProgram mdk_program;
+		mdk_program.program = std::move(image.program);
+		for (const auto& symbol : image.symbols)
+		{
+			mdk_program.symbols.emplace_back(symbol.first, long{symbol.second.value()});
+		}
+		return mdk_program;
+	}
+
+	void PrintControlFlowGraph(std::ostream& out, const ControlFlowGraph& graph)
+	{
+		for (const auto& block : graph.blocks)
+		{
+			out << block.begin_address << '-' << (block.end_address - 1) << ':';
+			for (int successor : block.successors)
+			{
+				out << ' ' << successor;
+			}
+			if (block.has_unknown_successor)
+			{
+				out << " ?";
+			}
+			out << '\n';
+		}
+		out << "Entry: " << graph.entry_address
+			<< ", blocks: " << graph.blocks.size() << '\n';
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		auto cmd_args = CreateOptions();
+		const Options options = OptionsFromCommandLine(cmd_args.parse(argc, argv));
+		if (options.show_help || (options.input.empty() == options.source.empty()))
+		{
+			std::cout << cmd_args.help() << '\n';
+			return 0;
+		}
+
+		const auto mdk_program = LoadProgram(options);
+
+		std::ofstream file;
+		if (!options.output.empty())
+		{
+			file.open(options.output, std::ios_base::binary);
+			if (!file)
+			{
+				throw std::runtime_error("Can't open `" + options.output + "` file");
+			}
+		}
+		std::ostream& out = options.output.empty() ? std::cout : file;
+
+		if (options.print_cfg)
+		{
+			PrintControlFlowGraph(out, BuildControlFlowGraph(mdk_program.program));
+			return 0;
+		}
+
+		const auto disassembled = Disassemble(mdk_program.program, mdk_program.symbols);
+		WriteDisassembledProgram(out, disassembled);
+		std::cerr << "Code words: " << disassembled.code_words_count
+			<< ", data words: " << disassembled.data_words_count << '\n';
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return -1;
+	}
+}
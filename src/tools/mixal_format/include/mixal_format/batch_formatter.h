@@ -0,0 +1,52 @@
+#pragma once
+#include <mixal_format/stream_formatter.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <iosfwd>
+
+#include <cstddef>
+
+namespace mixal_format {
+
+struct BatchOptions
+{
+	// `title_comment` is ignored: formatting of already formatted
+	// file should not change it
+	FormatOptions format;
+	// Files are not rewritten, only checked
+	bool check_only{false};
+	// 0 means "use all hardware threads"
+	std::size_t threads_count{0};
+	std::string extension{".mixal"};
+};
+
+struct FileResult
+{
+	std::filesystem::path path;
+	// Formatted text differs from the file
+	bool changed{false};
+	// Lines that failed to parse (they are kept as is)
+	std::size_t invalid_lines_count{0};
+	// Not empty when file can't be read or written
+	std::string error;
+};
+
+struct BatchReport
+{
+	// Sorted by path
+	std::vector<FileResult> files;
+	std::size_t changed_count{0};
+	std::size_t with_invalid_lines_count{0};
+	std::size_t failed_count{0};
+};
+
+// Formats every file with `options.extension` under `root` (recursively)
+// in parallel. Changed files are replaced with formatted text atomically
+// (written to temporary file that is renamed), unless `check_only` is set
+BatchReport FormatDirectory(const std::filesystem::path& root, const BatchOptions& options = {});
+
+void PrintReport(std::ostream& out, const BatchReport& report, bool check_only);
+
+} // namespace mixal_format
@@ -1,5 +1,9 @@
 #pragma once
+#include <iosfwd>
 #include <string>
+#include <string_view>
+
+#include <cstddef>
 
 namespace mixal_format {
 
@@ -8,9 +12,13 @@ struct FormatOptions
 	bool mdk_compatible = false;
 	bool make_all_uppercase = true;
 	std::string title_comment;
+	// Lines that failed to parse are written to std::cerr
+	bool report_errors = true;
 };
 
-void FormatStream(std::istream& in, std::ostream& out, const FormatOptions& options = {});
+// Returns count of lines that failed to parse (they are written as is)
+std::size_t FormatStream(std::istream& in, std::ostream& out, const FormatOptions& options = {});
+std::size_t FormatText(std::string_view text, std::ostream& out, const FormatOptions& options = {});
 
 } // namespace mixal_format
 
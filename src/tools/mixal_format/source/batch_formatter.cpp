@@ -0,0 +1,162 @@
+#include <mixal_format/batch_formatter.h>
+
+#include <core/thread_pool.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <ostream>
+
+namespace mixal_format {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+std::vector<fs::path> CollectFiles(const fs::path& root, const std::string& extension)
+{
+	std::vector<fs::path> files;
+	for (const auto& entry : fs::recursive_directory_iterator{root})
+	{
+		if (entry.is_regular_file() && (entry.path().extension() == extension))
+		{
+			files.push_back(entry.path());
+		}
+	}
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+bool ReadFile(const fs::path& path, std::string& text)
+{
+	std::ifstream in{path, std::ios_base::binary};
+	if (!in)
+	{
+		return false;
+	}
+	text.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+	return !in.bad();
+}
+
+// Written to unique temporary file first, so the file is never
+// seen partially written (and is kept as is on error)
+bool ReplaceFile(const fs::path& path, const std::string& text)
+{
+	std::error_code error;
+	auto temp_path = path;
+	temp_path += ".tmp" + std::to_string(std::random_device{}());
+	{
+		std::ofstream out{temp_path, std::ios_base::binary | std::ios_base::trunc};
+		if (!out)
+		{
+			return false;
+		}
+		out.write(text.data(), static_cast<std::streamsize>(text.size()));
+		if (!out.flush())
+		{
+			out.close();
+			fs::remove(temp_path, error);
+			return false;
+		}
+	}
+
+	fs::permissions(temp_path, fs::status(path).permissions(), error);
+	fs::rename(temp_path, path, error);
+	if (error)
+	{
+		fs::remove(temp_path, error);
+		return false;
+	}
+	return true;
+}
+
+FileResult FormatFile(const fs::path& path, const BatchOptions& options)
+{
+	FileResult result;
+	result.path = path;
+
+	std::string text;
+	if (!ReadFile(path, text))
+	{
+		result.error = "can't read file";
+		return result;
+	}
+
+	FormatOptions format = options.format;
+	format.title_comment.clear();
+	format.report_errors = false;
+
+	std::ostringstream out;
+	result.invalid_lines_count = FormatText(text, out, format);
+	const std::string formatted = std::move(out).str();
+	result.changed = (formatted != text);
+
+	if (result.changed && !options.check_only && !ReplaceFile(path, formatted))
+	{
+		result.error = "can't write file";
+	}
+	return result;
+}
+
+} // namespace
+
+BatchReport FormatDirectory(const std::filesystem::path& root, const BatchOptions& options /*= {}*/)
+{
+	BatchReport report;
+	const auto files = CollectFiles(root, options.extension);
+	report.files.resize(files.size());
+
+	{
+		core::ThreadPool pool{options.threads_count};
+		for (std::size_t i = 0; i < files.size(); ++i)
+		{
+			pool.submit([&files, &report, &options, i]()
+			{
+				report.files[i] = FormatFile(files[i], options);
+			});
+		}
+		pool.wait();
+	}
+
+	for (const auto& file : report.files)
+	{
+		report.changed_count += (file.changed ? 1 : 0);
+		report.with_invalid_lines_count += ((file.invalid_lines_count > 0) ? 1 : 0);
+		report.failed_count += (file.error.empty() ? 0 : 1);
+	}
+	return report;
+}
+
+void PrintReport(std::ostream& out, const BatchReport& report, bool check_only)
+{
+	for (const auto& file : report.files)
+	{
+		if (!file.error.empty())
+		{
+			out << file.path.string() << ": error: " << file.error << '\n';
+			continue;
+		}
+		if (file.changed)
+		{
+			out << file.path.string() << (check_only ? ": not formatted" : ": formatted");
+			if (file.invalid_lines_count > 0)
+			{
+				out << ", invalid lines: " << file.invalid_lines_count;
+			}
+			out << '\n';
+		}
+		else if (file.invalid_lines_count > 0)
+		{
+			out << file.path.string() << ": invalid lines: " << file.invalid_lines_count << '\n';
+		}
+	}
+
+	out << "Files: " << report.files.size()
+		<< (check_only ? ", not formatted: " : ", formatted: ") << report.changed_count
+		<< ", with invalid lines: " << report.with_invalid_lines_count
+		<< ", errors: " << report.failed_count << '\n';
+}
+
+} // namespace mixal_format
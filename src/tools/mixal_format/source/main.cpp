@@ -1,4 +1,5 @@
 #include <mixal_format/stream_formatter.h>
+#include <mixal_format/batch_formatter.h>
 
 #include <iostream>
 #include <fstream>
@@ -28,6 +29,9 @@ namespace
 		options.add_options()
 			("h,help",	"Show this help and exit")
 			("f,file",	"Input MIXAL source file", cxxopts::value<std::string>())
+			("d,directory",	"Format all .mixal files of the directory in place", cxxopts::value<std::string>())
+			("check",	"With --directory: only report files that are not formatted")
+			("j,jobs",	"With --directory: threads count (all hardware threads by default)", cxxopts::value<std::size_t>())
 			("m,mdk",	R"(Format to "GNU MIX Development Kit" syntax)")
 			("u,uppercase", "Make all symbols upper-case");
 		return options;
@@ -37,6 +41,9 @@ namespace
 	{
 		FormatOptions format;
 		std::string file;
+		std::string directory;
+		bool check_only = false;
+		std::size_t jobs = 0;
 		bool show_help = false;
 	};
 
@@ -49,6 +56,17 @@ namespace
 		{
 			options.file = file_opt.as<std::string>();
 		}
+		const auto directory_opt = cmd["directory"];
+		if (directory_opt.count() == 1)
+		{
+			options.directory = directory_opt.as<std::string>();
+		}
+		const auto jobs_opt = cmd["jobs"];
+		if (jobs_opt.count() == 1)
+		{
+			options.jobs = jobs_opt.as<std::size_t>();
+		}
+		options.check_only = (cmd.count("check") > 0);
 		options.show_help = (cmd.count("help") > 0);
 		options.format.mdk_compatible = (cmd.count("mdk") > 0);
 		options.format.make_all_uppercase = (cmd.count("uppercase") > 0);
@@ -69,6 +87,21 @@ int main(int argc, char* argv[])
 			return 0;
 		}
 
+		if (!options.directory.empty())
+		{
+			BatchOptions batch;
+			batch.format = options.format;
+			batch.check_only = options.check_only;
+			batch.threads_count = options.jobs;
+			const auto report = FormatDirectory(options.directory, batch);
+			PrintReport(std::cout, report, options.check_only);
+			if (report.failed_count > 0)
+			{
+				return 1;
+			}
+			return (options.check_only && (report.changed_count > 0)) ? 1 : 0;
+		}
+
 		if (options.format.mdk_compatible)
 		{
 			options.format.title_comment =
@@ -1,15 +1,15 @@
 #include <mixal_format/stream_formatter.h>
 
-#include <mixal_parse/line_parser.h>
+#include <mixal_parse/parsed_lines_stream.h>
 #include <mixal_parse/parsers_utils.h>
 
+#include <core/line_reader.h>
 #include <core/string.h>
 
 #include <sstream>
 #include <iomanip>
 #include <iostream>
 #include <algorithm>
-#include <iterator>
 
 #include <cassert>
 #include <cctype>
@@ -20,17 +20,13 @@ namespace {
 
 using namespace mixal_parse;
 
-std::string ToUpper(const std::string& str)
+void ToUpperInPlace(core::Span<char> str)
 {
-	std::string all_upper_case;
-	all_upper_case.reserve(str.size());
-	std::transform(str.cbegin(), str.cend(),
-		std::back_inserter(all_upper_case),
+	std::transform(str.begin(), str.end(), str.begin(),
 		[](char ch)
 	{
-		return static_cast<char>(std::toupper(ch));
+		return static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
 	});
-	return all_upper_case;
 }
 
 const std::size_t k_address_str_width = 20;
@@ -140,39 +136,45 @@ std::string BuildLine(const LineParser& line_parser, const FormatOptions& option
 	}
 }
 
-std::string FormatLine(const std::string& line, const FormatOptions& options /*= {}*/)
+std::string FormatLine(const ParsedLine& line, const FormatOptions& options /*= {}*/)
 {
-	std::string_view line_view{core::Trim(line)};
-	if (line_view.empty())
+	if (line.is_empty())
 	{
 		return {};
 	}
 
-	LineParser line_parser;
-	if (IsInvalidStreamPosition(line_parser.parse_stream(line_view)))
+	if (!line.parser)
 	{
-		std::cerr << "Failed to parse MIXAL line of code: \n\t"
-			<< line_view << "\n";
-		return line;
+		if (options.report_errors)
+		{
+			std::cerr << "Failed to parse MIXAL line of code: \n\t"
+				<< core::Trim(line.text) << "\n";
+		}
+		return std::string{line.text};
 	}
 
-	return BuildLine(line_parser, options);
+	return BuildLine(*line.parser, options);
 }
 
-} // namespace
-
-void FormatStream(std::istream& in, std::ostream& out, const FormatOptions& options /*= {}*/)
+std::size_t FormatLines(core::LineReader& reader, std::ostream& out, const FormatOptions& options)
 {
 	if (!options.title_comment.empty())
 	{
 		out << "* " << options.title_comment << "\n";
 	}
 
-	std::string line;
-	while (getline(in, line))
+	ParsedLinesStream lines{reader,
+		options.make_all_uppercase ? &ToUpperInPlace : ParsedLinesStream::LineTransform{},
+		true/*trim lines*/};
+	ParsedLine line;
+	std::size_t invalid_lines_count = 0;
+	while (lines.next(line))
 	{
-		line = options.make_all_uppercase ? ToUpper(line) : line;
-		
+		if (line.is_invalid())
+		{
+			++invalid_lines_count;
+		}
+
 		const auto formatted_line = FormatLine(line, options);
 		if (formatted_line.empty() && options.mdk_compatible)
 		{
@@ -182,6 +184,21 @@ void FormatStream(std::istream& in, std::ostream& out, const FormatOptions& opti
 		out << formatted_line << '\n';
 		assert(out);
 	}
+	return invalid_lines_count;
+}
+
+} // namespace
+
+std::size_t FormatStream(std::istream& in, std::ostream& out, const FormatOptions& options /*= {}*/)
+{
+	core::LineReader reader{core::ByteSource::FromStream(in)};
+	return FormatLines(reader, out, options);
+}
+
+std::size_t FormatText(std::string_view text, std::ostream& out, const FormatOptions& options /*= {}*/)
+{
+	core::LineReader reader{core::ByteSource::FromMemory(text)};
+	return FormatLines(reader, out, options);
 }
 
 } // namespace mixal_format
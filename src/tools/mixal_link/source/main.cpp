@@ -0,0 +1,150 @@
+#include <mixal/object_module.h>
+#include <mixal/mdk_program_loader.h>
+#include <mixal/exceptions.h>
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(__clang__)
+#  pragma clang diagnostic push
+// Comes from <regex>, -Wno-sign-compare on command line does not help
+//
+// comparison of integers of different signs
+#  pragma clang diagnostic ignored "-Wsign-compare"
+#endif
+
+#include <cxxopts.hpp>
+
+#if defined(_MSC_VER) && defined(__clang__)
+#  pragma clang diagnostic pop
+#endif
+
+using namespace mixal;
+
+namespace
+{
+	cxxopts::Options CreateOptions()
+	{
+		cxxopts::Options options{"mixal_link",
+			"Compiles MIXAL modules and links them into MIX program (MDK format)"};
+		options.add_options()
+			("h,help",		"Show this help and exit")
+			("c,compile",	"Compile single MIXAL <input> into object module")
+			("i,input",		"Input file: MIXAL code to compile or object module to link (can be repeated)",
+				cxxopts::value<std::vector<std::string>>())
+			("o,output",	"Output file: object module or linked program", cxxopts::value<std::string>())
+			("b,base",		"Address of the first linked module (0 by default)", cxxopts::value<int>());
+		return options;
+	}
+
+	struct Options
+	{
+		std::vector<std::string> inputs;
+		std::string output;
+		bool compile = false;
+		bool show_help = false;
+		int base_address = 0;
+	};
+
+	Options OptionsFromCommandLine(const cxxopts::ParseResult& cmd)
+	{
+		Options options;
+
+		if (cmd["input"].count() > 0)
+		{
+			options.inputs = cmd["input"].as<std::vector<std::string>>();
+		}
+		if (cmd["output"].count() == 1)
+		{
+			options.output = cmd["output"].as<std::string>();
+		}
+		if (cmd["base"].count() == 1)
+		{
+			options.base_address = cmd["base"].as<int>();
+		}
+		options.compile = (cmd.count("compile") > 0);
+		options.show_help = (cmd.count("help") > 0);
+
+		return options;
+	}
+
+	std::ofstream OpenOutput(const std::string& file_name)
+	{
+		std::ofstream output(file_name, std::ios_base::binary);
+		if (!output)
+		{
+			throw std::runtime_error("Can't open `" + file_name + "` file");
+		}
+		return output;
+	}
+
+	void Compile(const Options& options)
+	{
+		if (options.inputs.size() != 1)
+		{
+			throw std::runtime_error("Exactly one input is expected for compilation");
+		}
+
+		const auto module = TranslateModule(SourceBuffer::FromFile(options.inputs.front()));
+		auto output = OpenOutput(options.output);
+		WriteObjectModule(output, module);
+
+		std::cout << "Words: " << module.words.size()
+			<< ", relocations: " << module.relocations.size()
+			<< ", imports: " << module.imports.size()
+			<< ", exports: " << module.exports.size() << '\n';
+	}
+
+	void Link(const Options& options)
+	{
+		std::vector<ObjectModule> modules;
+		for (const auto& file_name : options.inputs)
+		{
+			std::ifstream input(file_name, std::ios_base::binary);
+			if (!input)
+			{
+				throw std::runtime_error("Can't open `" + file_name + "` file");
+			}
+			modules.push_back(ReadObjectModule(input));
+		}
+
+		MDKProgram mdk_program;
+		mdk_program.program = LinkModules(modules, options.base_address);
+		auto output = OpenOutput(options.output);
+		WriteMDKProgram(output, mdk_program);
+
+		std::cout << "Linked words count: " << mdk_program.program.commands.size() << '\n';
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		auto cmd_args = CreateOptions();
+		const Options options = OptionsFromCommandLine(cmd_args.parse(argc, argv));
+		if (options.show_help || options.inputs.empty() || options.output.empty())
+		{
+			std::cout << cmd_args.help() << '\n';
+			return 0;
+		}
+
+		if (options.compile)
+		{
+			Compile(options);
+		}
+		else
+		{
+			Link(options);
+		}
+		return 0;
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << '\n';
+		return -1;
+	}
+}